@@ -1,46 +1,64 @@
 #include "AIPlayer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <cmath>
 #include <random>
 #include "ConnectFour.h"
+#include "MNKGame.h"
+#include "MonteCarlo.h"
+#include "ProofNumber.h"
+#include "Qubic.h"
+#include "Tablebase.h"
 #include "TicTacToe.h"
 #include "Theme.h"
 
 namespace
 {
 	//0 = Very Easy, 1 = Easy, 2 = Medium, 3 = Hard, 4 = Very Hard
-	static int g_aiDifficultyIndex = 2; // default to Medium
+	static std::atomic<int> g_aiDifficultyIndex{ 2 }; // default to Medium
 	// Theme index:0=Classic,1=Nature,2=Strawberry,3=Beachy,4=Dark
 	static ThemeIndex g_themeIndex = ThemeIndex::Classic; // default to Classic
 
-	double difficultyFactor()
+	// Per-move cost and noise of each tier. Budgets are hard limits: the deepest iteration that
+	// completes within them is played, so the cost per move does not depend on the game phase.
+	const DifficultyProfile kDifficultyProfiles[5] = {
+		{ 2000, 30, 60, SearchStrategy::AlphaBeta, 0 },      // Very Easy
+		{ 12000, 60, 30, SearchStrategy::AlphaBeta, 0 },     // Easy
+		{ 60000, 150, 12, SearchStrategy::AlphaBeta, 0 },    // Medium
+		{ 250000, 300, 4, SearchStrategy::AlphaBeta, 0 },    // Hard
+		{ 1000000, 600, 0, SearchStrategy::AlphaBeta, 50 },  // Very Hard
+	};
+
+	const int kHintProofFillPercent = 50;
+	const std::uint64_t kProofNodeLimit = 300000; // per attempt when the config has no node budget
+	const std::uint64_t kThreatNodeLimit = 50000; // same for the m,n,k threat-space search
+	const int kMaxThreats = 8; // attacker moves in a forced line found by threat-space search
+
+	// Share of the Connect 4 board (any size) that is filled; 0 for other games
+	int connectFourFillPercent(const Game& game)
 	{
-		switch (g_aiDifficultyIndex)
-		{
-		case 0: return 0.30; // Very Easy
-		case 1: return 0.45; // Easy
-		case 2: return 0.65; // Medium
-		case 3: return 0.80; // Hard
-		case 4: // fallthrough
-		default: return 1.0; // Very Hard
-		}
+		auto c4 = dynamic_cast<const ConnectBoard*>(&game);
+		if (!c4)
+			return 0;
+		return c4->stoneCount() * 100 / (c4->width() * c4->height());
 	}
 
 	bool isBoardEmpty(const Game& game)
 	{
-		if (auto c4 = dynamic_cast<const ConnectFour*>(&game))
-		{
-			for (int row = 0; row < ConnectFour::HEIGHT; ++row)
-			{
-				for (int col = 0; col < ConnectFour::WIDTH; ++col)
-				{
-					if (c4->getCell(row, col) != Player::None)
-						return false;
-				}
-			}
-			return true;
-		}
+		if (auto c4 = dynamic_cast<const ConnectBoard*>(&game))
+			return c4->stoneCount() == 0;
+
+		if (auto mnk = dynamic_cast<const MNKGame*>(&game))
+			return mnk->stoneCount() == 0;
+
+		if (auto qubic = dynamic_cast<const Qubic*>(&game))
+			return qubic->stoneCount() == 0;
 
 		if (auto ttt = dynamic_cast<const TicTacToe*>(&game))
 		{
@@ -55,16 +73,19 @@ namespace
 		return false;
 	}
 
+	// Center-first preference per game, used to break ties and to order moves in the search;
+	// Connect 4 boards supply theirs through ConnectBoard::columnOrder()
+	const int kTTTPriorityOrder[9] = {4, 0, 2, 6, 8, 1, 3, 5, 7};
+
 	Game::Move choosePreferredMove(const Game& game, const std::vector<Game::Move>& bestMoves)
 	{
-		if (auto c4 = dynamic_cast<const ConnectFour*>(&game))
+		if (auto c4 = dynamic_cast<const ConnectBoard*>(&game))
 		{
-			const int centerPreference[] = {3, 2, 4, 1, 5, 0, 6};
-			for (int col : centerPreference)
+			for (int i = 0; i < c4->width(); ++i)
 			{
 				for (auto move : bestMoves)
 				{
-					if (move == col)
+					if (move == c4->columnOrder()[i])
 						return move;
 				}
 			}
@@ -72,8 +93,7 @@ namespace
 
 		if (auto ttt = dynamic_cast<const TicTacToe*>(&game))
 		{
-			const int priorityOrder[] = {4, 0, 2, 6, 8, 1, 3, 5, 7};
-			for (int pos : priorityOrder)
+			for (int pos : kTTTPriorityOrder)
 			{
 				for (auto move : bestMoves)
 				{
@@ -85,6 +105,80 @@ namespace
 
 		return bestMoves.front();
 	}
+
+	// Reorders moves by the same preference, so late move reductions hit the edge moves
+	void orderMoves(const Game& game, std::vector<Game::Move>& moves)
+	{
+		const int* order = nullptr;
+		size_t count = 0;
+		if (auto c4 = dynamic_cast<const ConnectBoard*>(&game))
+		{
+			order = c4->columnOrder();
+			count = static_cast<size_t>(c4->width());
+		}
+		else if (dynamic_cast<const TicTacToe*>(&game))
+		{
+			order = kTTTPriorityOrder;
+			count = 9;
+		}
+		if (!order)
+			return;
+
+		std::vector<Game::Move> ordered;
+		ordered.reserve(moves.size());
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (std::find(moves.begin(), moves.end(), order[i]) != moves.end())
+				ordered.push_back(order[i]);
+		}
+		moves.swap(ordered);
+	}
+
+	// Takes what a root shortcut (proof or threat search) spent since start off config's budgets
+	void chargeBudget(EngineConfig& config, std::uint64_t nodes, std::chrono::steady_clock::time_point start)
+	{
+		if (config.nodeBudget)
+			config.nodeBudget = std::max<std::uint64_t>(1, config.nodeBudget - std::min(config.nodeBudget, nodes));
+		if (config.timeBudgetMs > 0)
+		{
+			const auto spent = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+			config.timeBudgetMs = std::max(1, config.timeBudgetMs - static_cast<int>(spent));
+		}
+	}
+}
+
+const DifficultyProfile& getDifficultyProfile(int difficultyIndex)
+{
+	if (difficultyIndex < 0) difficultyIndex = 0;
+	if (difficultyIndex > 4) difficultyIndex = 4;
+	return kDifficultyProfiles[difficultyIndex];
+}
+
+EngineConfig EngineConfig::forDifficulty(int difficultyIndex, int maxDepth)
+{
+	const DifficultyProfile& profile = getDifficultyProfile(difficultyIndex);
+	EngineConfig config;
+	config.maxDepth = maxDepth;
+	config.nodeBudget = profile.nodeBudget;
+	config.timeBudgetMs = profile.timeBudgetMs;
+	config.evalNoise = profile.evalNoise;
+	config.strategy = profile.strategy;
+	config.proofFillPercent = profile.proofFillPercent;
+	return config;
+}
+
+EngineConfig EngineConfig::forCurrentDifficulty(int maxDepth)
+{
+	return forDifficulty(g_aiDifficultyIndex.load(), maxDepth);
+}
+
+EngineConfig EngineConfig::fullStrength(int maxDepth)
+{
+	EngineConfig config;
+	config.maxDepth = maxDepth;
+	config.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+	config.proofFillPercent = kHintProofFillPercent;
+	return config;
 }
 
 // Setter used by the UI to change difficulty at runtime
@@ -113,123 +207,17 @@ extern "C" int getThemeIndex()
 
 int evaluateHeuristic(const Game& state, Player aiPlayer)
 {
-	if (auto c4 = dynamic_cast<const ConnectFour*>(&state))
-	{
-		int score = 0;
-		Player opponent = (aiPlayer == Player::X) ? Player::O : Player::X;
-
-		// Scan for threats and opportunities (sequences of 2 and 3)
-		for (int row = 0; row < ConnectFour::HEIGHT; ++row)
-		{
-			for (int col = 0; col < ConnectFour::WIDTH; ++col)
-			{
-				Player p = c4->getCell(row, col);
-				if (p == Player::None) continue;
+	// Threats and opportunities (runs and open pairs) plus center control, on bitboards
+	if (auto c4 = dynamic_cast<const ConnectBoard*>(&state))
+		return c4->evaluate(aiPlayer);
 
-				// Horizontal sequences
-				if (col + 2 < ConnectFour::WIDTH)
-				{
-					Player p1 = c4->getCell(row, col + 1);
-					Player p2 = c4->getCell(row, col + 2);
-					
-					// 3-in-a-row: critical threat
-					if (p == p1 && p1 == p2)
-					{
-						if (p == aiPlayer)
-							score += 50;   // AI winning opportunity
-						else
-							score -= 50;   // Opponent threat
-					}
-					// 2-in-a-row
-					else if (p == p1 && p2 == Player::None)
-					{
-						if (p == aiPlayer)
-							score += 10;
-						else
-							score -= 10;
-					}
-				}
-
-				// Vertical sequences
-				if (row + 2 < ConnectFour::HEIGHT)
-				{
-					Player p1 = c4->getCell(row + 1, col);
-					Player p2 = c4->getCell(row + 2, col);
-					
-					if (p == p1 && p1 == p2)
-					{
-						if (p == aiPlayer)
-							score += 50;
-						else
-							score -= 50;
-					}
-					else if (p == p1 && p2 == Player::None)
-					{
-						if (p == aiPlayer)
-							score += 10;
-						else
-							score -= 10;
-					}
-				}
+	// Open windows of each player, weighted by how full they are; kept up to date move by move
+	if (auto mnk = dynamic_cast<const MNKGame*>(&state))
+		return mnk->evaluate(aiPlayer);
 
-				// Diagonal (down-right)
-				if (col + 2 < ConnectFour::WIDTH && row + 2 < ConnectFour::HEIGHT)
-				{
-					Player p1 = c4->getCell(row + 1, col + 1);
-					Player p2 = c4->getCell(row + 2, col + 2);
-					
-					if (p == p1 && p1 == p2)
-					{
-						if (p == aiPlayer)
-							score += 50;
-						else
-							score -= 50;
-					}
-					else if (p == p1 && p2 == Player::None)
-					{
-						if (p == aiPlayer)
-							score += 10;
-						else
-							score -= 10;
-					}
-				}
-
-				// Diagonal (down-left)
-				if (col - 2 >= 0 && row + 2 < ConnectFour::HEIGHT)
-				{
-					Player p1 = c4->getCell(row + 1, col - 1);
-					Player p2 = c4->getCell(row + 2, col - 2);
-					
-					if (p == p1 && p1 == p2)
-					{
-						if (p == aiPlayer)
-							score += 50;
-						else
-							score -= 50;
-					}
-					else if (p == p1 && p2 == Player::None)
-					{
-						if (p == aiPlayer)
-							score += 10;
-						else
-							score -= 10;
-					}
-				}
-			}
-		}
-
-		// Bonus for center positions (helps with strategy when no threats exist)
-		for (int row = 0; row < ConnectFour::HEIGHT; ++row)
-		{
-			Player p = c4->getCell(row, 3);
-			if (p == aiPlayer)
-				score += 2;
-			else if (p == opponent)
-				score -= 2;
-		}
-
-		return score;
-	}
+	// Same for the 76 lines of the cube
+	if (auto qubic = dynamic_cast<const Qubic*>(&state))
+		return qubic->evaluate(aiPlayer);
 
 	if (auto ttt = dynamic_cast<const TicTacToe*>(&state))
 	{
@@ -288,116 +276,996 @@ int evaluateTerminal(const Game& state, Player aiPlayer, int depthRemaining)
 	return evaluateHeuristic(state, aiPlayer);
 }
 
-int minimax(std::unique_ptr<Game> node, int depth, bool maximizing, int alpha, int beta, Player aiPlayer)
+namespace
 {
-	if (depth == 0 || node->isGameOver())
-		return evaluateTerminal(*node, aiPlayer, depth);
+	// Triangular principal variation table. Row p holds the best line found below the node at
+	// ply p (ply 0 = a child of the root), copied up a row whenever a move becomes best there.
+	struct PVTable
+	{
+		static constexpr int kMaxPly = 128;
+		std::vector<Game::Move> moves = std::vector<Game::Move>(kMaxPly * kMaxPly);
+		int length[kMaxPly]{};
 
-	const auto moves = node->getValidMoves();
-	if (moves.empty())
-		return evaluateTerminal(*node, aiPlayer, depth);
+		void clear(int ply)
+		{
+			if (ply < kMaxPly)
+				length[ply] = ply;
+		}
+
+		void update(int ply, Game::Move move)
+		{
+			if (ply >= kMaxPly)
+				return;
+			Game::Move* row = &moves[ply * kMaxPly];
+			row[ply] = move;
+			length[ply] = ply + 1;
+			if (ply + 1 >= kMaxPly)
+				return;
+			const Game::Move* childRow = &moves[(ply + 1) * kMaxPly];
+			for (int i = ply + 1; i < length[ply + 1]; ++i)
+				row[i] = childRow[i];
+			length[ply] = std::max(length[ply], length[ply + 1]);
+		}
+
+		// The root move followed by the line below it
+		std::vector<Game::Move> rootLine(Game::Move rootMove) const
+		{
+			std::vector<Game::Move> line{ rootMove };
+			line.insert(line.end(), moves.begin(), moves.begin() + length[0]);
+			return line;
+		}
+	};
+
+	// Work done between two pauses of a search capped below a full core (EngineConfig::cpuShare)
+	const std::chrono::milliseconds kCpuSlice{ 10 };
 
-	if (maximizing)
+	// Per-search state threaded through the recursion.
+	struct SearchContext
 	{
-		int best = std::numeric_limits<int>::min();
-		for (auto move : moves)
+		Player aiPlayer{ Player::None };
+		std::uint64_t nodes{ 0 };
+		const std::atomic<bool>* stop{ nullptr };
+		const std::atomic<bool>* cancel{ nullptr };
+		std::uint64_t nodeLimit{ 0 }; // 0 = unlimited
+		bool hasDeadline{ false };
+		std::chrono::steady_clock::time_point deadline;
+		double cpuShare{ 1.0 };
+		std::chrono::steady_clock::time_point sliceStart; // start of the current slice of work
+		bool aborted{ false };
+		TranspositionTable* table{ nullptr };
+		const Tablebase* tablebase{ nullptr };
+		PVTable* pv{ nullptr }; // collects the principal variation when set
+		int ply{ 0 };
+
+		// Polls the stop flag every node and the clock every 1024 nodes.
+		bool shouldAbort()
 		{
-			auto next = node->clone();
-			if (!next->makeMove(move))
-				continue;
+			if (aborted)
+				return true;
+			if (stopped())
+				aborted = true;
+			else if (nodeLimit && nodes > nodeLimit)
+				aborted = true;
+			else if ((hasDeadline || cpuShare < 1.0) && (nodes & 1023) == 0 && clockExpired())
+				aborted = true;
+			return aborted;
+		}
+
+		bool stopped() const
+		{
+			return (stop && stop->load(std::memory_order_relaxed)) || (cancel && cancel->load(std::memory_order_relaxed));
+		}
+
+		// With cpuShare below 1, every kCpuSlice of work is followed by a pause of
+		// (1 - cpuShare) / cpuShare times its length, cut short by the stop flags.
+		bool clockExpired()
+		{
+			auto now = std::chrono::steady_clock::now();
+			if (cpuShare < 1.0 && now - sliceStart >= kCpuSlice)
+			{
+				const auto pauseEnd = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+					(now - sliceStart) * ((1.0 - cpuShare) / cpuShare));
+				while (now < pauseEnd && !stopped())
+				{
+					std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(pauseEnd - now, kCpuSlice));
+					now = std::chrono::steady_clock::now();
+				}
+				sliceStart = now;
+			}
+			return hasDeadline && now >= deadline;
+		}
+	};
+}
+
+namespace
+{
+	// Win/loss scores are 1000 + depth remaining at the terminal node, which depends on where the
+	// search started. The table stores them as plies to the terminal node instead.
+	const int kTableMateBase = 10000;
 
-			const int score = minimax(std::move(next), depth - 1, false, alpha, beta, aiPlayer);
-			if (score > best)
-				best = score;
+	int scoreToTable(int score, int depth)
+	{
+		if (score >= 1000)
+			return kTableMateBase - (depth - (score - 1000));
+		if (score <= -1000)
+			return -kTableMateBase + (depth - (-score - 1000));
+		return score;
+	}
 
-			if (score > alpha)
-				alpha = score;
+	int scoreFromTable(int score, int depth)
+	{
+		if (score >= kTableMateBase / 2)
+			return 1000 + std::max(0, depth - (kTableMateBase - score));
+		if (score <= -kTableMateBase / 2)
+			return -1000 - std::max(0, depth - (kTableMateBase + score));
+		return score;
+	}
 
-			if (beta <= alpha)
+	// Tablebase value (+/- plies to the end, side to move's view) on the same scale
+	int scoreFromTablebase(int value, int depth)
+	{
+		if (value > 0)
+			return 1000 + std::max(0, depth - value);
+		if (value < 0)
+			return -1000 - std::max(0, depth + value);
+		return 0;
+	}
+
+	// Table key of a node: mirrored/rotated variants of a position share one entry, with moves
+	// stored in the canonical frame.
+	struct TableKey
+	{
+		std::uint64_t key{ 0 };
+		int symmetry{ 0 };
+	};
+
+	TableKey tableKeyOf(const Game& game)
+	{
+		TableKey k;
+		k.key = game.getCanonicalKey(k.symmetry);
+		return k;
+	}
+
+	// A principal variation stops where the search took a score from the table; the table's best
+	// moves continue it from there, up to maxLength moves and as long as they are legal.
+	void extendFromTable(const Game& game, std::vector<Game::Move>& line, const TranspositionTable* table, int maxLength)
+	{
+		auto node = game.clone();
+		for (size_t i = 0; i < line.size(); ++i)
+		{
+			if (!node->makeMove(line[i]))
+			{
+				line.resize(i);
+				return;
+			}
+		}
+		if (!table)
+			return;
+		while (static_cast<int>(line.size()) < maxLength && !node->isGameOver())
+		{
+			const TableKey key = tableKeyOf(*node);
+			TranspositionTable::Entry entry;
+			if (!table->probe(key.key, entry) || entry.move < 0)
 				break;
+			const Game::Move next = node->fromCanonicalMove(entry.move, key.symmetry);
+			if (!node->makeMove(next))
+				break;
+			line.push_back(next);
 		}
-		return best;
 	}
-	else
+
+	// Moves from this index on are searched with a late move reduction first
+	const size_t kLateMoveIndex = 3;
+
+	// The only move that does not lose immediately, or -1 if there is none or several
+	Game::Move forcedBlock(const Game& node, const std::vector<Game::Move>& moves)
 	{
-		int best = std::numeric_limits<int>::max();
+		const Player me = node.getCurrentPlayer();
+		const Player opponent = (me == Player::X) ? Player::O : Player::X;
+		Game::Move block = -1;
+		int threats = 0;
 		for (auto move : moves)
 		{
-			auto next = node->clone();
-			if (!next->makeMove(move))
+			if (node.isWinningMove(me, move))
+				return -1;
+			if (node.isWinningMove(opponent, move))
+			{
+				block = move;
+				++threats;
+			}
+		}
+		return (threats == 1) ? block : -1;
+	}
+}
+
+// key is tableKeyOf(*node), computed by the caller; only read when ctx.table is set and depth > 0.
+int minimax(std::unique_ptr<Game> node, TableKey key, int depth, bool maximizing, int alpha, int beta, SearchContext& ctx)
+{
+	if (ctx.pv)
+		ctx.pv->clear(ctx.ply);
+	++ctx.nodes;
+	if (ctx.shouldAbort())
+		return 0; // result is discarded by the root
+
+	if (depth == 0 || node->isGameOver())
+		return evaluateTerminal(*node, ctx.aiPlayer, depth);
+
+	// Mate-distance pruning: no line from here scores beyond a win or loss at this depth
+	const int mateBound = 1000 + depth;
+	if (alpha >= mateBound)
+		return mateBound;
+	if (beta <= -mateBound)
+		return -mateBound;
+
+	// Table scores are from the side to move's point of view; the search maximizes for aiPlayer
+	const int sign = maximizing ? 1 : -1;
+	if (ctx.tablebase)
+	{
+		int value;
+		if (ctx.tablebase->probe(ctx.table ? key.key : tableKeyOf(*node).key, value))
+			return sign * scoreFromTablebase(value, depth);
+	}
+
+	auto moves = node->getValidMoves();
+	if (moves.empty())
+		return evaluateTerminal(*node, ctx.aiPlayer, depth);
+	orderMoves(*node, moves);
+
+	using Bound = TranspositionTable::Bound;
+	if (ctx.table)
+	{
+		TranspositionTable::Entry entry;
+		if (ctx.table->probe(key.key, entry))
+		{
+			if (entry.depth >= depth)
+			{
+				const int score = sign * scoreFromTable(entry.score, depth);
+				Bound bound = entry.bound;
+				if (!maximizing && bound != Bound::Exact)
+					bound = (bound == Bound::Lower) ? Bound::Upper : Bound::Lower;
+
+				if (bound == Bound::Exact
+					|| (bound == Bound::Lower && score >= beta)
+					|| (bound == Bound::Upper && score <= alpha))
+					return score;
+			}
+
+			// Try the stored move first either way
+			auto it = std::find(moves.begin(), moves.end(), node->fromCanonicalMove(entry.move, key.symmetry));
+			if (it != moves.end())
+				std::rotate(moves.begin(), it, it + 1);
+		}
+	}
+
+	// Forced block: if we cannot win at once and the opponent threatens exactly one winning move,
+	// every other move loses on the spot. Only the block is searched, and one ply deeper.
+	const Game::Move forced = forcedBlock(*node, moves);
+	if (forced >= 0)
+		moves.assign(1, forced);
+	const int childDepth = (forced >= 0) ? depth : depth - 1;
+
+	// Searches one child. Late moves (poorly ordered, so rarely best) are first probed one ply
+	// shallower with a null window and only searched in full if the probe beats the bound.
+	auto searchChild = [&](std::unique_ptr<Game> next, size_t index) {
+		// Leaves never probe, so only interior children need their key and bucket
+		const TableKey nextKey = (ctx.table && childDepth > 0) ? tableKeyOf(*next) : TableKey();
+		if (ctx.table && childDepth > 0)
+			ctx.table->prefetch(nextKey.key); // overlaps the load with the child's setup
+
+		if (index >= kLateMoveIndex && childDepth >= 2)
+		{
+			const int probeAlpha = maximizing ? alpha : beta - 1;
+			const int probeBeta = maximizing ? alpha + 1 : beta;
+			++ctx.ply;
+			const int reduced = minimax(next->clone(), nextKey, childDepth - 1, !maximizing, probeAlpha, probeBeta, ctx);
+			--ctx.ply;
+			const bool beatsBound = maximizing ? (reduced > alpha) : (reduced < beta);
+			if (!beatsBound || ctx.aborted)
+				return reduced;
+		}
+		++ctx.ply;
+		const int score = minimax(std::move(next), nextKey, childDepth, !maximizing, alpha, beta, ctx);
+		--ctx.ply;
+		return score;
+	};
+
+	const int alphaOrig = alpha;
+	const int betaOrig = beta;
+	Game::Move bestMove = -1;
+	int best = maximizing ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
+	for (size_t i = 0; i < moves.size(); ++i)
+	{
+		auto next = node->clone();
+		if (!next->makeMove(moves[i]))
+			continue;
+
+		const int score = searchChild(std::move(next), i);
+		if (maximizing ? (score > best) : (score < best))
+		{
+			best = score;
+			bestMove = moves[i];
+			if (ctx.pv)
+				ctx.pv->update(ctx.ply, bestMove);
+		}
+
+		if (maximizing && score > alpha)
+			alpha = score;
+		if (!maximizing && score < beta)
+			beta = score;
+
+		if (beta <= alpha)
+			break;
+	}
+
+	if (ctx.table && !ctx.aborted && bestMove >= 0)
+	{
+		Bound bound = Bound::Exact;
+		if (best <= alphaOrig)
+			bound = Bound::Upper;
+		else if (best >= betaOrig)
+			bound = Bound::Lower;
+		if (!maximizing && bound != Bound::Exact)
+			bound = (bound == Bound::Lower) ? Bound::Upper : Bound::Lower;
+		ctx.table->store(key.key, scoreToTable(sign * best, depth), depth, bound, node->toCanonicalMove(bestMove, key.symmetry));
+	}
+	return best;
+}
+
+namespace
+{
+	// Random blur added to root scores by the weaker tiers.
+	struct RootNoise
+	{
+		int amount{ 0 };
+		std::mt19937* rng{ nullptr };
+
+		int apply(int score) const
+		{
+			// Forced wins/losses are never blurred
+			if (amount <= 0 || !rng || std::abs(score) >= 1000)
+				return score;
+			return score + std::uniform_int_distribution<int>(-amount, amount)(*rng);
+		}
+	};
+
+	// Root moves are searched with alpha one below the best score so far, because a fail-soft bound
+	// equal to the best would otherwise pass for a tie. With noise, moves up to 2*noise below the
+	// best still need a real score to compete.
+	int rootWindow(int alpha, const RootNoise& noise)
+	{
+		const int margin = 1 + std::max(0, 2 * noise.amount);
+		if (alpha > std::numeric_limits<int>::min() + margin)
+			return alpha - margin;
+		return alpha;
+	}
+
+	// Each root worker gets an equal share of what is left of the node budget
+	std::uint64_t workerNodeLimit(const SearchContext& ctx, int threads)
+	{
+		if (!ctx.nodeLimit)
+			return 0;
+		return std::max<std::uint64_t>(1, (ctx.nodeLimit > ctx.nodes ? ctx.nodeLimit - ctx.nodes : 0) / threads);
+	}
+
+	// Context of one root worker thread: the same limits and tables, its own node count
+	SearchContext workerContext(const SearchContext& ctx, std::uint64_t nodeLimit)
+	{
+		SearchContext local;
+		local.aiPlayer = ctx.aiPlayer;
+		local.stop = ctx.stop;
+		local.cancel = ctx.cancel;
+		local.table = ctx.table;
+		local.tablebase = ctx.tablebase;
+		local.nodeLimit = nodeLimit;
+		local.hasDeadline = ctx.hasDeadline;
+		local.deadline = ctx.deadline;
+		local.cpuShare = ctx.cpuShare;
+		local.sliceStart = std::chrono::steady_clock::now();
+		return local;
+	}
+
+	// Scores every root move at minimaxDepth. Sequential with threads <= 1; otherwise the root
+	// moves are handed out to worker threads that share the best score found so far as alpha.
+	// Moves never searched (abort) keep valid[i] == false; lines[i] is move i's principal variation.
+	void scoreRootMoves(const Game& game, const std::vector<Game::Move>& moves, int minimaxDepth, SearchContext& ctx,
+		const RootNoise& noise, int threads, std::vector<int>& scores, std::vector<char>& valid,
+		std::vector<std::vector<Game::Move>>& lines)
+	{
+		scores.assign(moves.size(), 0);
+		valid.assign(moves.size(), 0);
+		lines.assign(moves.size(), std::vector<Game::Move>());
+		const int beta = std::numeric_limits<int>::max();
+
+		if (threads <= 1 || moves.size() < 2)
+		{
+			PVTable pv;
+			ctx.pv = &pv;
+			int alpha = std::numeric_limits<int>::min();
+			for (size_t i = 0; i < moves.size(); ++i)
+			{
+				auto next = game.clone();
+				if (!next->makeMove(moves[i]))
+					continue;
+
+				const TableKey key = ctx.table ? tableKeyOf(*next) : TableKey();
+				const int score = minimax(std::move(next), key, minimaxDepth - 1, false, rootWindow(alpha, noise), beta, ctx);
+				if (ctx.aborted)
+					break;
+
+				scores[i] = score;
+				valid[i] = 1;
+				lines[i] = pv.rootLine(moves[i]);
+				if (score > alpha)
+					alpha = score;
+			}
+			ctx.pv = nullptr;
+			return;
+		}
+
+		std::mutex alphaMutex;
+		int sharedAlpha = std::numeric_limits<int>::min();
+		std::atomic<size_t> nextMove{ 0 };
+		std::atomic<std::uint64_t> totalNodes{ 0 };
+		std::atomic<bool> anyAborted{ false };
+
+		const std::uint64_t nodeLimit = workerNodeLimit(ctx, threads);
+		const int workerCount = std::min<int>(threads, static_cast<int>(moves.size()));
+		std::vector<std::thread> workers;
+		for (int t = 0; t < workerCount; ++t)
+		{
+			workers.emplace_back([&]() {
+				SearchContext local = workerContext(ctx, nodeLimit);
+				PVTable pv;
+				local.pv = &pv;
+				for (size_t i = nextMove++; i < moves.size() && !anyAborted; i = nextMove++)
+				{
+					auto next = game.clone();
+					if (!next->makeMove(moves[i]))
+						continue;
+
+					int alpha;
+					{
+						std::lock_guard<std::mutex> lock(alphaMutex);
+						alpha = sharedAlpha;
+					}
+
+					const TableKey key = local.table ? tableKeyOf(*next) : TableKey();
+					const int score = minimax(std::move(next), key, minimaxDepth - 1, false, rootWindow(alpha, noise), beta, local);
+					if (local.aborted)
+					{
+						anyAborted = true;
+						break;
+					}
+
+					scores[i] = score;
+					valid[i] = 1;
+					lines[i] = pv.rootLine(moves[i]);
+					std::lock_guard<std::mutex> lock(alphaMutex);
+					if (score > sharedAlpha)
+						sharedAlpha = score;
+				}
+				totalNodes += local.nodes;
+				});
+		}
+		for (auto& w : workers)
+			w.join();
+
+		ctx.nodes += totalNodes;
+		if (anyAborted)
+			ctx.aborted = true;
+	}
+
+	// Runs the root loop at a fixed depth and collects every move sharing the best (noisy) score.
+	// An aborted search reports aborted = true and its move/score must not be trusted.
+	SearchResult searchRoot(const Game& game, int depth, SearchContext& ctx, std::vector<Game::Move>& bestMoves,
+		const RootNoise& noise = RootNoise(), int threads = 1)
+	{
+		SearchResult result;
+		bestMoves.clear();
+
+		// The existing logic calls minimax with (depth -1) after making the candidate move
+		const int minimaxDepth = std::max(1, depth);
+		result.depth = minimaxDepth;
+
+		ctx.aiPlayer = game.getCurrentPlayer();
+		const std::uint64_t nodesBefore = ctx.nodes;
+		const auto moves = game.getValidMoves();
+		if (moves.empty())
+			return result;
+
+		std::vector<int> scores;
+		std::vector<char> valid;
+		std::vector<std::vector<Game::Move>> lines;
+		scoreRootMoves(game, moves, minimaxDepth, ctx, noise, threads, scores, valid, lines);
+
+		// Pick in move order so ties (and the noise draws) do not depend on thread timing
+		int bestNoisy = std::numeric_limits<int>::min();
+		int bestScore = std::numeric_limits<int>::min();
+		for (size_t i = 0; i < moves.size(); ++i)
+		{
+			if (!valid[i])
 				continue;
 
-			const int score = minimax(std::move(next), depth - 1, true, alpha, beta, aiPlayer);
-			if (score < best)
-				best = score;
+			const int noisy = noise.apply(scores[i]);
+			if (noisy > bestNoisy)
+			{
+				bestNoisy = noisy;
+				bestScore = scores[i];
+				bestMoves.clear();
+				bestMoves.push_back(moves[i]);
+			}
+			else if (noisy == bestNoisy)
+			{
+				bestMoves.push_back(moves[i]);
+			}
+		}
+
+		result.nodes = ctx.nodes - nodesBefore;
+		result.aborted = ctx.aborted;
+		if (bestMoves.empty())
+		{
+			result.move = moves.front();
+			return result;
+		}
+
+		result.score = bestScore;
+		result.move = choosePreferredMove(game, bestMoves);
+		result.pv = lines[std::find(moves.begin(), moves.end(), result.move) - moves.begin()];
+		extendFromTable(game, result.pv, ctx.table, minimaxDepth);
+		return result;
+	}
+
+	// Iterative deepening up to maxDepth within the context's limits. Returns the deepest completed
+	// iteration (bestMoves holds its tied moves); a partial one only if not even depth 1 finished.
+	SearchResult iterate(const Game& game, int maxDepth, SearchContext& ctx, const RootNoise& noise, int threads,
+		const std::function<void(const SearchResult&)>& onIteration, std::vector<Game::Move>& bestMoves)
+	{
+		SearchResult best;
+		std::vector<Game::Move> iterationMoves;
+		for (int depth = 1; depth <= std::max(1, maxDepth); ++depth)
+		{
+			SearchResult result = searchRoot(game, depth, ctx, iterationMoves, noise, threads);
+			if (result.aborted)
+			{
+				if (best.move < 0)
+				{
+					best = result;
+					bestMoves = iterationMoves;
+				}
+				best.aborted = true;
+				best.nodes = ctx.nodes;
+				break;
+			}
 
-			if (score < beta)
-				beta = score;
+			result.nodes = ctx.nodes;
+			best = result;
+			bestMoves = iterationMoves;
+			if (onIteration)
+				onIteration(best);
 
-			if (beta <= alpha)
+			// A proven win or loss will not change with more depth
+			if (std::abs(best.score) >= 1000)
 				break;
 		}
 		return best;
 	}
+
+	SearchContext makeContext(const EngineConfig& config, const std::atomic<bool>* stop, TranspositionTable& table,
+		const Tablebase* tablebase)
+	{
+		SearchContext ctx;
+		ctx.stop = stop;
+		if (config.useTable)
+		{
+			table.newSearch();
+			ctx.table = &table;
+		}
+		if (config.useTablebase)
+			ctx.tablebase = tablebase;
+		ctx.cancel = config.cancel;
+		ctx.nodeLimit = config.nodeBudget;
+		if (config.timeBudgetMs > 0)
+		{
+			ctx.hasDeadline = true;
+			ctx.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(config.timeBudgetMs);
+		}
+		if (config.cpuShare > 0.0 && config.cpuShare < 1.0)
+		{
+			ctx.cpuShare = config.cpuShare;
+			ctx.sliceStart = std::chrono::steady_clock::now();
+		}
+		return ctx;
+	}
+
+	// Half width of a root move's analysis window around its score from the previous depth
+	const int kAspirationWindow = 32;
+
+	// Searched moves before unsearched ones, exact scores before bounds, then by score
+	bool ranksBefore(const MoveAnalysis& a, const MoveAnalysis& b)
+	{
+		if ((a.depth > 0) != (b.depth > 0))
+			return a.depth > 0;
+		if (a.exact != b.exact)
+			return a.exact;
+		return a.score > b.score;
+	}
+
+	// One multi-PV iteration: searches every move of entries (ranked by the previous depth) to
+	// depth in its own window. With lines > 0, once that many exact scores are known the others
+	// only have to beat the lines-th best; a move that does not ends up with an upper bound.
+	// Entries finished before an abort keep their new result; returns false on abort.
+	bool analyzeDepth(const Game& game, int depth, SearchContext& ctx, int lines, int threads, std::vector<MoveAnalysis>& entries)
+	{
+		const int minScore = std::numeric_limits<int>::min();
+		const int maxScore = std::numeric_limits<int>::max();
+		std::mutex scoresMutex;
+		std::vector<int> exactScores; // at this depth
+		std::atomic<size_t> nextMove{ 0 };
+		std::atomic<bool> anyAborted{ false };
+
+		auto work = [&](SearchContext& local) {
+			PVTable pv;
+			local.pv = &pv;
+			for (size_t i = nextMove++; i < entries.size() && !anyAborted; i = nextMove++)
+			{
+				MoveAnalysis& entry = entries[i];
+				auto child = game.clone();
+				if (!child->makeMove(entry.move))
+					continue;
+				const TableKey key = local.table ? tableKeyOf(*child) : TableKey();
+
+				int floor = minScore;
+				if (lines > 0)
+				{
+					std::lock_guard<std::mutex> lock(scoresMutex);
+					if (exactScores.size() >= static_cast<size_t>(lines))
+					{
+						std::nth_element(exactScores.begin(), exactScores.begin() + (lines - 1), exactScores.end(), std::greater<int>());
+						floor = exactScores[lines - 1] - 1;
+					}
+				}
+
+				// Mate scores change with depth, so only a heuristic score gets a narrow window
+				int low = minScore;
+				int high = maxScore;
+				if (entry.depth > 0 && entry.exact && std::abs(entry.score) < 1000)
+				{
+					low = entry.score - kAspirationWindow;
+					high = entry.score + kAspirationWindow;
+				}
+
+				int score = 0;
+				bool exact = true;
+				for (;;)
+				{
+					const int alpha = std::max(low, floor);
+					score = minimax(child->clone(), key, depth - 1, false, alpha, high, local);
+					if (local.aborted)
+						break;
+					if (score >= high && high != maxScore)
+					{
+						high = maxScore;
+						continue;
+					}
+					if (score <= alpha && alpha != minScore)
+					{
+						exact = alpha != floor;
+						if (!exact)
+							break;
+						low = minScore;
+						continue;
+					}
+					break;
+				}
+				if (local.aborted)
+				{
+					anyAborted = true;
+					break;
+				}
+
+				entry.score = score;
+				entry.depth = depth;
+				entry.exact = exact;
+				entry.pv = pv.rootLine(entry.move);
+				if (exact)
+				{
+					std::lock_guard<std::mutex> lock(scoresMutex);
+					exactScores.push_back(score);
+				}
+			}
+			local.pv = nullptr;
+		};
+
+		if (threads <= 1 || entries.size() < 2)
+		{
+			work(ctx);
+			return !ctx.aborted;
+		}
+
+		const std::uint64_t nodeLimit = workerNodeLimit(ctx, threads);
+		const int workerCount = std::min<int>(threads, static_cast<int>(entries.size()));
+		std::atomic<std::uint64_t> totalNodes{ 0 };
+		std::vector<std::thread> workers;
+		for (int t = 0; t < workerCount; ++t)
+		{
+			workers.emplace_back([&]() {
+				SearchContext local = workerContext(ctx, nodeLimit);
+				work(local);
+				totalNodes += local.nodes;
+				});
+		}
+		for (auto& w : workers)
+			w.join();
+
+		ctx.nodes += totalNodes;
+		if (anyAborted)
+			ctx.aborted = true;
+		return !ctx.aborted;
+	}
 }
 
-Game::Move AIPlayer::chooseMove(const Game& game, int maxDepth)
+AIPlayer::AIPlayer(std::size_t tableMegabytes)
+	: _table(tableMegabytes)
 {
-	if (maxDepth < 1)
-		maxDepth = 1;
+}
 
-	// Compute effective search depth based on difficulty
-	const double factor = difficultyFactor();
-	int effectiveDepth = static_cast<int>(std::round(maxDepth * factor));
-	if (effectiveDepth < 1)
-		effectiveDepth = 1;
+AIPlayer::~AIPlayer() = default;
 
-	// The existing logic calls minimax with (depth -1) after making the candidate move
-	const int minimaxDepth = std::max(1, effectiveDepth);
+void AIPlayer::stop()
+{
+	_stop = true;
+}
 
-	const Player aiPlayer = game.getCurrentPlayer();
-	const auto moves = game.getValidMoves();
-	if (moves.empty())
-		return -1;
+SearchResult AIPlayer::search(const Game& game, int depth, int threads)
+{
+	_stop = false;
+	_table.clear();
+	SearchContext ctx;
+	ctx.stop = &_stop;
+	ctx.table = &_table;
+	ctx.tablebase = _tablebase.get();
+	std::vector<Game::Move> bestMoves;
+	return searchRoot(game, depth, ctx, bestMoves, RootNoise(), threads);
+}
+
+SearchResult AIPlayer::searchIterative(const Game& game, const EngineConfig& config, const std::function<void(const SearchResult&)>& onIteration)
+{
+	_stop = false;
+	if (config.strategy == SearchStrategy::MonteCarlo)
+	{
+		// No depth iterations to report; the tree search runs once over the whole budget
+		SearchResult result = searchMonteCarlo(game, config, &_stop);
+		if (onIteration)
+			onIteration(result);
+		return result;
+	}
+	SearchContext ctx = makeContext(config, &_stop, _table, _tablebase.get());
+
+	std::random_device rd;
+	std::mt19937 gen(rd());
+	RootNoise noise;
+	noise.amount = config.evalNoise;
+	noise.rng = &gen;
 
-	int bestScore = std::numeric_limits<int>::min();
 	std::vector<Game::Move> bestMoves;
-	int alpha = std::numeric_limits<int>::min();
-	int beta = std::numeric_limits<int>::max();
+	return iterate(game, config.maxDepth, ctx, noise, config.threads, onIteration, bestMoves);
+}
+
+Analysis AIPlayer::analyze(const Game& game, const EngineConfig& config, int lines, const std::function<void(const Analysis&)>& onIteration)
+{
+	_stop = false;
+	Analysis analysis;
+	if (game.isGameOver())
+		return analysis;
+	for (auto move : game.getValidMoves())
+	{
+		MoveAnalysis entry;
+		entry.move = move;
+		analysis.moves.push_back(entry);
+	}
+	if (analysis.moves.empty())
+		return analysis;
 
-	for (auto move : moves)
+	SearchContext ctx = makeContext(config, &_stop, _table, _tablebase.get());
+	ctx.aiPlayer = game.getCurrentPlayer();
+	for (int depth = 1; depth <= std::max(1, config.maxDepth); ++depth)
+	{
+		const bool completed = analyzeDepth(game, depth, ctx, lines, config.threads, analysis.moves);
+		std::stable_sort(analysis.moves.begin(), analysis.moves.end(), ranksBefore);
+		for (auto& entry : analysis.moves)
+		{
+			if (entry.depth == depth)
+				extendFromTable(game, entry.pv, ctx.table, depth);
+		}
+		analysis.nodes = ctx.nodes;
+		if (!completed)
+		{
+			analysis.aborted = true;
+			break;
+		}
+
+		analysis.depth = depth;
+		if (onIteration)
+			onIteration(analysis);
+
+		// Done once every move is a proven win or loss, or bounded below a loss
+		const bool decided = std::all_of(analysis.moves.begin(), analysis.moves.end(), [](const MoveAnalysis& entry) {
+			return entry.exact ? std::abs(entry.score) >= 1000 : entry.score <= -1000;
+			});
+		if (decided)
+			break;
+	}
+	return analysis;
+}
+
+bool AIPlayer::playTablebaseMove(const Game& game, const EngineConfig& config, SearchResult& result)
+{
+	if (!_tablebase || !config.useTablebase || config.evalNoise != 0)
+		return false;
+
+	// Rank: win in n plies = 1000 - n, draw = 0, loss in n plies = -1000 + n
+	const Player mover = game.getCurrentPlayer();
+	Game::Move bestMove = -1;
+	int bestRank = std::numeric_limits<int>::min();
+	int bestPlies = 0;
+	for (Game::Move move : game.getValidMoves())
 	{
 		auto next = game.clone();
 		if (!next->makeMove(move))
 			continue;
 
-		const int score = minimax(std::move(next), minimaxDepth - 1, false, alpha, beta, aiPlayer);
-		if (score > bestScore)
+		int plies = 1;
+		int rank = 0;
+		if (next->isGameOver())
+		{
+			rank = (next->getWinner() == mover) ? 1000 - plies : 0;
+		}
+		else
 		{
-			bestScore = score;
-			bestMoves.clear();
-			bestMoves.push_back(move);
+			int symmetry;
+			int value;
+			if (!_tablebase->probe(next->getCanonicalKey(symmetry), value))
+				return false; // not covered: let the search decide
+			plies = std::abs(value) + 1;
+			rank = (value < 0) ? 1000 - plies : (value > 0) ? -1000 + plies : 0;
 		}
-		else if (score == bestScore)
+		if (rank > bestRank)
 		{
-			bestMoves.push_back(move);
+			bestRank = rank;
+			bestMove = move;
+			bestPlies = plies;
 		}
+	}
+	if (bestMove < 0)
+		return false;
 
-		if (score > alpha)
-			alpha = score;
+	result = SearchResult();
+	result.move = bestMove;
+	result.score = (bestRank > 0) ? 1000 : (bestRank < 0) ? -1000 : 0;
+	result.depth = (bestRank != 0) ? bestPlies : 0;
+	return true;
+}
+
+bool AIPlayer::playProvenWin(const Game& game, EngineConfig& config, SearchResult& result)
+{
+	if (config.proofFillPercent <= 0 || connectFourFillPercent(game) < config.proofFillPercent)
+		return false;
+	if (!_proof)
+		_proof = std::make_unique<ProofSearch>();
+
+	// The proof attempt may use half of the move's budget; the regular search gets the rest
+	const auto start = std::chrono::steady_clock::now();
+	const std::uint64_t nodeLimit = config.nodeBudget ? std::max<std::uint64_t>(1, config.nodeBudget / 2) : kProofNodeLimit;
+	const ProofSearch::Result proof = _proof->prove(game, nodeLimit, config.timeBudgetMs / 2, &_stop, config.cancel);
+	if (proof.value == ProofSearch::Value::Win)
+	{
+		result = SearchResult();
+		result.move = proof.move;
+		result.score = 1000;
+		result.nodes = proof.nodes;
+		return true;
+	}
+
+	chargeBudget(config, proof.nodes, start);
+	return false;
+}
+
+bool AIPlayer::playThreatSpaceWin(const Game& game, EngineConfig& config, SearchResult& result)
+{
+	auto mnk = dynamic_cast<const MNKGame*>(&game);
+	if (!mnk || config.evalNoise != 0)
+		return false;
+
+	// Like the proof attempt: at most half of the move's budget, the rest goes to the search
+	const auto start = std::chrono::steady_clock::now();
+	const std::uint64_t nodeLimit = config.nodeBudget ? std::max<std::uint64_t>(1, config.nodeBudget / 2) : kThreatNodeLimit;
+	const MNKGame::ThreatResult threat = mnk->findThreatWin(kMaxThreats, nodeLimit, config.timeBudgetMs / 2, &_stop, config.cancel);
+	if (threat.move >= 0)
+	{
+		result = SearchResult();
+		result.move = threat.move;
+		result.score = 1000;
+		result.nodes = threat.nodes;
+		return true;
+	}
+
+	chargeBudget(config, threat.nodes, start);
+	return false;
+}
+
+SearchResult AIPlayer::chooseMoveDetailed(const Game& game, const EngineConfig& requested)
+{
+	_stop = false;
+	EngineConfig config = requested;
+	SearchResult exact;
+	if (playTablebaseMove(game, config, exact) || playProvenWin(game, config, exact) || playThreatSpaceWin(game, config, exact))
+	{
+		exact.pv.assign(1, exact.move);
+		return exact;
+	}
+	if (config.strategy == SearchStrategy::MonteCarlo)
+	{
+		SearchResult result = searchMonteCarlo(game, config, &_stop);
+		if (result.move >= 0)
+			result.pv.assign(1, result.move);
+		return result;
 	}
+	SearchContext ctx = makeContext(config, &_stop, _table, _tablebase.get());
 
-	if (bestMoves.empty())
-		return moves.front();
+	std::random_device rd;
+	std::mt19937 gen(rd());
+	RootNoise noise;
+	noise.amount = config.evalNoise;
+	noise.rng = &gen;
+
+	std::vector<Game::Move> bestMoves;
+	SearchResult result = iterate(game, config.maxDepth, ctx, noise, config.threads, nullptr, bestMoves);
 
 	// Randomize only the opening move for variety, then stay deterministic
 	if (bestMoves.size() > 1 && isBoardEmpty(game))
 	{
-		std::random_device rd;
-		std::mt19937 gen(rd());
 		std::uniform_int_distribution<> dis(0, static_cast<int>(bestMoves.size()) - 1);
-		return bestMoves[dis(gen)];
+		const Game::Move move = bestMoves[dis(gen)];
+		if (move != result.move)
+			result.pv.assign(1, move);
+		result.move = move;
 	}
+	return result;
+}
+
+Game::Move AIPlayer::chooseMove(const Game& game, const EngineConfig& config)
+{
+	return chooseMoveDetailed(game, config).move;
+}
 
-	return choosePreferredMove(game, bestMoves);
+Game::Move AIPlayer::chooseMove(const Game& game, int maxDepth)
+{
+	return chooseMove(game, EngineConfig::forCurrentDifficulty(maxDepth));
+}
+
+bool AIPlayer::saveTable(const std::string& path) const
+{
+	return _table.save(path);
+}
+
+bool AIPlayer::loadTable(const std::string& path)
+{
+	return _table.load(path);
+}
+
+void AIPlayer::setTablebase(std::shared_ptr<const Tablebase> tablebase)
+{
+	_tablebase = std::move(tablebase);
+}
+
+void AIPlayer::clearTable()
+{
+	_table.clear();
+	if (_proof)
+		_proof->clear();
+}
+
+void AIPlayer::setTableSize(std::size_t megabytes, bool hugePages)
+{
+	_table.resize(megabytes, hugePages);
 }
@@ -1,6 +1,15 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <random>
+#include <string>
 #include <vector>
+#include "TranspositionTable.h"
+
+class ProofSearch;
+class Tablebase;
 
 enum class Player
 {
@@ -19,6 +28,41 @@ public:
     virtual std::vector<Move> getValidMoves() const = 0;
     virtual Player checkWin() const = 0;
     virtual bool isDraw() const = 0;
+    // Unique key of the board and side to move.
+    virtual std::uint64_t getKey() const = 0;
+
+    // Key shared by every symmetric variant of the position (what search caches index by).
+    // symmetry receives the transform mapping this position onto the canonical one (0 = identity);
+    // the move functions translate move indices between the two frames. Default: no symmetries.
+    virtual std::uint64_t getCanonicalKey(int& symmetry) const
+    {
+        symmetry = 0;
+        return getKey();
+    }
+    virtual Move toCanonicalMove(Move move, int /*symmetry*/) const { return move; }
+    virtual Move fromCanonicalMove(Move move, int /*symmetry*/) const { return move; }
+
+    // Plays uniformly random moves to the end of the game and returns the winner (None = draw).
+    // The default works through clone/makeMove; games override it with bitboard playouts.
+    virtual Player randomPlayout(std::mt19937& rng) const
+    {
+        auto copy = clone();
+        while (!copy->isGameOver())
+        {
+            const auto moves = copy->getValidMoves();
+            if (moves.empty())
+                return Player::None;
+            copy->makeMove(moves[rng() % moves.size()]);
+        }
+        return copy->getWinner();
+    }
+
+    // True if player playing move right now would complete a line, whoever's turn it is.
+    virtual bool isWinningMove(Player player, Move move) const
+    {
+        auto copy = clone();
+        return copy->placeMove(player, move) && copy->checkWin() == player;
+    }
 
     Player getCurrentPlayer() const { return _currentPlayer; }
     Player getWinner() const { return _winner; }
@@ -71,9 +115,155 @@ protected:
     bool _gameOver{ false };
 };
 
+// Outcome of a single search: best move, its score from the mover's point of view,
+// the depth actually searched and how many nodes were visited.
+struct SearchResult
+{
+    Game::Move move{ -1 };
+    int score{ 0 };
+    int depth{ 0 };
+    std::uint64_t nodes{ 0 };
+    bool aborted{ false }; // stopped or out of time before the depth completed
+    std::vector<Game::Move> pv; // expected line, starting with move (only the move for shortcuts and Monte Carlo)
+};
+
+// One root move of an analysis: its score from the mover's point of view at the depth it was last
+// searched to, and the line the search expects after it (starting with the move itself).
+struct MoveAnalysis
+{
+    Game::Move move{ -1 };
+    int score{ 0 };
+    int depth{ 0 };      // 0 = not searched yet
+    bool exact{ false }; // false: score is only an upper bound (the move is outside the requested lines)
+    std::vector<Game::Move> pv;
+};
+
+// Every root move ranked best first, as returned by AIPlayer::analyze.
+struct Analysis
+{
+    std::vector<MoveAnalysis> moves;
+    int depth{ 0 };  // deepest iteration completed for all moves
+    std::uint64_t nodes{ 0 };
+    bool aborted{ false };
+};
+
+// Static evaluation of a non-terminal position from aiPlayer's point of view.
+int evaluateHeuristic(const Game& state, Player aiPlayer);
+
+// Search algorithm behind a move.
+enum class SearchStrategy
+{
+    AlphaBeta,  // iterative deepening minimax; budgets count nodes
+    MonteCarlo  // UCT tree search with random playouts; budgets count playouts
+};
+
+// What a difficulty tier may spend per move and how much random noise blurs its move choice.
+struct DifficultyProfile
+{
+    std::uint64_t nodeBudget;
+    int timeBudgetMs;
+    int evalNoise; // +/- points added to non-decisive root move scores (alpha-beta only)
+    SearchStrategy strategy;
+    int proofFillPercent; // see EngineConfig
+};
+
+// Profile of tier 0 (Very Easy) .. 4 (Very Hard).
+const DifficultyProfile& getDifficultyProfile(int difficultyIndex);
+
+// Settings for one search, passed by value so concurrent searches (e.g. a full-strength hint
+// while the opponent plays at Easy) never share mutable state.
+struct EngineConfig
+{
+    int maxDepth{ 8 };
+    std::uint64_t nodeBudget{ 0 }; // 0 = unlimited
+    int timeBudgetMs{ 0 };         // 0 = unlimited
+    int threads{ 1 };              // root moves are split across this many threads
+    int evalNoise{ 0 };            // see DifficultyProfile
+    const std::atomic<bool>* cancel{ nullptr }; // optional caller-owned flag that aborts the search when set
+    bool useTable{ true };         // probe and fill the AIPlayer's transposition table
+    SearchStrategy strategy{ SearchStrategy::AlphaBeta };
+    bool mctsPriors{ true };       // Monte Carlo: bias new children by evaluateHeuristic
+    bool mctsRootParallel{ false }; // Monte Carlo: one tree per thread, root visits summed at the end
+    bool useTablebase{ true };     // probe the AIPlayer's endgame tablebase, if it has one
+    int proofFillPercent{ 0 };     // Connect 4: from this board fill on, chooseMove first tries to prove a
+                                   // forced win with proof-number search (0 = never)
+    double cpuShare{ 1.0 };        // alpha-beta: below 1, each thread pauses between short slices of work
+                                   // to stay at this fraction of a core (background analysis)
+
+    // Budgets and noise of the given tier, deepening up to maxDepth.
+    static EngineConfig forDifficulty(int difficultyIndex, int maxDepth);
+    // Tier currently selected in Settings; snapshot it on the thread that schedules the search.
+    static EngineConfig forCurrentDifficulty(int maxDepth);
+    // No budget, no noise, all hardware threads (hints, analysis).
+    static EngineConfig fullStrength(int maxDepth);
+};
+
 class AIPlayer
 {
 public:
+    explicit AIPlayer(std::size_t tableMegabytes = TranspositionTable::kDefaultMegabytes);
+    ~AIPlayer();
+
     // Returns the chosen move for the current player of the provided game state.
+    // Deepens up to config.maxDepth within the config's budgets.
+    Game::Move chooseMove(const Game& game, const EngineConfig& config);
+
+    // Same as chooseMove(game, EngineConfig::forCurrentDifficulty(maxDepth)).
     Game::Move chooseMove(const Game& game, int maxDepth = 8);
+
+    // chooseMove together with the score, depth reached and node count. A proven win (see
+    // EngineConfig::proofFillPercent) is reported with score 1000 and depth 0; once proven, the
+    // winning line is played from the proof table without searching again. Without noise, a
+    // position the tablebase covers is answered from it (score +/-1000 or 0, depth = plies to the end),
+    // and an m,n,k-game position with a forced win by threats is answered like a proven win.
+    SearchResult chooseMoveDetailed(const Game& game, const EngineConfig& config);
+
+    // Deterministic full-strength search to exactly the given depth, without budgets or noise.
+    // Starts from an empty transposition table so the result depends only on the position.
+    // Used by the headless tools.
+    SearchResult search(const Game& game, int depth = 8, int threads = 1);
+
+    // Iterative deepening up to config.maxDepth within its budgets, without opening randomization.
+    // onIteration is called after every completed depth; the deepest completed result is returned.
+    SearchResult searchIterative(const Game& game, const EngineConfig& config,
+        const std::function<void(const SearchResult&)>& onIteration = nullptr);
+
+    // Multi-PV search: one iterative deepening that scores every legal move. Each root move is
+    // searched in a window around its score from the previous depth and re-searched only if it
+    // falls outside. With lines > 0 only the best lines get exact scores; the rest are searched
+    // against the lines-th best and report an upper bound. Budgets, threads and cancel come from
+    // config; noise, the strategy and the root shortcuts (proofs, tablebase moves) do not apply.
+    // If the budget runs out mid-iteration, moves already finished keep their deeper result.
+    Analysis analyze(const Game& game, const EngineConfig& config, int lines = 0,
+        const std::function<void(const Analysis&)>& onIteration = nullptr);
+
+    // Asks a search running on another thread to return as soon as possible.
+    void stop();
+
+    // The transposition table persists across chooseMove calls and games. A snapshot can be
+    // saved and loaded back later (e.g. at the next start of the app).
+    bool saveTable(const std::string& path) const;
+    bool loadTable(const std::string& path);
+    void clearTable();
+
+    // Exact Connect 4 endgame values, probed by the search and used directly at the root.
+    // May be shared between AIPlayers; set it only while no search is running.
+    void setTablebase(std::shared_ptr<const Tablebase> tablebase);
+    // Reallocates the (emptied) table; call only while no search is running.
+    void setTableSize(std::size_t megabytes, bool hugePages = false);
+
+private:
+    // Tries to prove a forced win when config asks for it; on failure the time and nodes spent
+    // are taken off config's budgets.
+    bool playProvenWin(const Game& game, EngineConfig& config, SearchResult& result);
+    // m,n,k-games without noise: plays the first move of a forced win found by threat-space
+    // search; budgets are charged like playProvenWin's.
+    bool playThreatSpaceWin(const Game& game, EngineConfig& config, SearchResult& result);
+    // Best move by the tablebase if it covers every child of the position.
+    bool playTablebaseMove(const Game& game, const EngineConfig& config, SearchResult& result);
+
+    std::atomic<bool> _stop{ false };
+    TranspositionTable _table;
+    std::unique_ptr<ProofSearch> _proof; // created on first use
+    std::shared_ptr<const Tablebase> _tablebase;
 };
@@ -14,15 +14,22 @@
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <limits>
+#include <vector>
 #include <cmath>
 #include <gui/GridLayout.h>
 #include <gui/TabView.h>
 #include <gui/BaseView.h>
 #include "ConnectFour.h"
 #include "AIPlayer.h"
+#include "Tablebase.h"
 #include "Theme.h"
 
 extern "C" int getThemeIndex();
+extern "C" int getAIDifficultyIndex();
 
 #ifndef CONNECTXO_UI_FONT
 #if defined(__APPLE__)
@@ -39,8 +46,10 @@ class Connect4View : public gui::Canvas
 public:
 	Connect4View()
 		: Canvas({ gui::InputDevice::Event::PrimaryClicks, gui::InputDevice::Event::CursorMove })
-		, _game()
+		, _game(makeConnectBoard(ConnectVariant::Classic))
 		, _aiPlayer()
+		, _hintPlayer()
+		, _ponderPlayer()
 		, _imgToken1()
 		, _imgToken2()
 		, _imgWood() // used in NATURE / LOG CABIN theme
@@ -71,11 +80,38 @@ public:
 	{
 		setPreferredFrameRateRange(60, 60);
 		enableResizeEvent(true);
-		_game.reset(Player::X); // player X goes first (human)
+		_game = makeConnectBoard(selectedBoard());
+		_game->reset(Player::X); // player X goes first (human)
 
 		// Load persisted scores from ScoreManager
 		_winCounter = ScoreManager::getInstance().getC4Stats().wins;
 		_lossCounter = ScoreManager::getInstance().getC4Stats().losses;
+
+		// Results cached by earlier sessions answer the first moves without a fresh search
+		_tableSnapshotPath = ScoreManager::getDataFilePath("c4-table.bin");
+		if (!_tableSnapshotPath.empty())
+			_aiPlayer.loadTable(_tableSnapshotPath);
+
+		// Endgame tablebase built with connectxo-tablebase, if one is installed; mapped once and
+		// shared by all engines
+		auto tablebase = std::make_shared<Tablebase>();
+		const std::string tablebasePath = ScoreManager::getDataFilePath("c4-endgame.cxtb");
+		if (!tablebasePath.empty() && tablebase->open(tablebasePath))
+		{
+			_aiPlayer.setTablebase(tablebase);
+			_hintPlayer.setTablebase(tablebase);
+			_ponderPlayer.setTablebase(tablebase);
+			_analysisPlayer.setTablebase(tablebase);
+		}
+	}
+
+	~Connect4View()
+	{
+		stopAISearch();
+		stopHint();
+		stopAnalysis();
+		stopPondering();
+		saveTableSnapshot(); // only now is nothing searching with _aiPlayer's table
 	}
 
 	// Allow parent to handle closing/removing this view
@@ -88,51 +124,6 @@ protected:
 		reDraw();
 	}
 
-	// Helper: find the4-in-a-row winning line (returns linear indices row*WIDTH+col)
-	std::vector<int> getWinningLine() const
-	{
-		std::vector<int> line;
-		for (int row = 0; row < ConnectFour::HEIGHT; ++row)
-		{
-			for (int col = 0; col < ConnectFour::WIDTH; ++col)
-			{
-				Player p = _game.getCell(row, col);
-				if (p == Player::None)
-					continue;
-
-				// directions: right, up, up-right, up-left
-				const int dirs[4][2] = { {1,0}, {0,1}, {1,1}, {-1,1} };
-				for (const auto& d : dirs)
-				{
-					int dx = d[0];
-					int dy = d[1];
-					bool ok = true;
-					std::vector<int> tmp;
-					tmp.push_back(row * ConnectFour::WIDTH + col);
-					for (int k = 1; k < 4; ++k)
-					{
-						int nr = row + dy * k;
-						int nc = col + dx * k;
-						if (nr < 0 || nr >= ConnectFour::HEIGHT || nc < 0 || nc >= ConnectFour::WIDTH)
-						{
-							ok = false;
-							break;
-						}
-						if (_game.getCell(nr, nc) != p)
-						{
-							ok = false;
-							break;
-						}
-						tmp.push_back(nr * ConnectFour::WIDTH + nc);
-					}
-					if (ok && tmp.size() == 4)
-						return tmp;
-				}
-			}
-		}
-		return {};
-	}
-
 	void onDraw(const gui::Rect& rect) override
 	{
 		// pick theme
@@ -263,7 +254,7 @@ protected:
 		// Draw centered "connectFour" title
 		gui::Font titleFont;
 		titleFont.create(CONNECTXO_UI_FONT, 37.0f, gui::Font::Style::Bold, gui::Font::Unit::Point);
-		td::String titleText = tr("connectFour");
+		td::String titleText = (_game->runLength() == 5) ? tr("connectFive") : tr("connectFour");
 		gui::DrawableString::draw(titleText, titleRect, &titleFont, textLblColor, td::TextAlignment::Center, td::VAlignment::Center);
 
 		// ===== ROW 2: Game Board + Buttons =====
@@ -272,8 +263,8 @@ protected:
 		// ROW 2, COLUMNS 1 & 2: Game Board Area
 		gui::Rect boardAreaRect(rect.left, row2Top, rect.left + 2.0 * col1Width, row2Top + row2Height);
 
-		constexpr int rows = ConnectFour::HEIGHT;
-		constexpr int cols = ConnectFour::WIDTH;
+		const int rows = _game->height();
+		const int cols = _game->width();
 
 		// Calculate board size to fit in the board area
 		double maxCellWidth = boardAreaRect.width() / cols;
@@ -297,7 +288,7 @@ protected:
 		gui::Shape::drawRect(boardPanel, bgColor, borderStroke);
 
 
-		// Draw grid cells (6 rows x 7 columns of circles)
+		// Draw grid cells (one circle per slot)
 		for (int r = 0; r < rows; ++r)
 		{
 			for (int c = 0; c < cols; ++c)
@@ -332,9 +323,11 @@ protected:
 		}
 
 		// Draw tokens already placed on the board
-		std::vector<int> winningLine = _game.isGameOver() ? getWinningLine() : std::vector<int>();
+		// The game records its winning run on the winning move
+		int lineRow0 = 0, lineCol0 = 0, lineRow1 = 0, lineCol1 = 0;
+		const bool hasWinningLine = _game->winningLineEnds(lineRow0, lineCol0, lineRow1, lineCol1);
 		float pulseScale = 1.0f;
-		if (!winningLine.empty())
+		if (hasWinningLine)
 		{
 			// Calculate win pulse animation
 			auto now = std::chrono::steady_clock::now();
@@ -347,19 +340,15 @@ protected:
 		{
 			for (int c = 0; c < cols; ++c)
 			{
-				Player p = _game.getCell(r, c);
+				Player p = _game->getCell(r, c);
 				if (p == Player::None)
 					continue;
 
 				// Check if this token is part of winning line
 				float tokenScale = 1.0f;
-				if (!winningLine.empty())
+				if (hasWinningLine && _game->isOnWinningLine(r, c))
 				{
-					int linearIdx = r * ConnectFour::WIDTH + c;
-					if (std::find(winningLine.begin(), winningLine.end(), linearIdx) != winningLine.end())
-					{
-						tokenScale = pulseScale;
-					}
+					tokenScale = pulseScale;
 				}
 				drawToken(getTokenRectForCell(r, c), p, false, highlightCOL, tokenScale);
 			}
@@ -369,23 +358,36 @@ protected:
 		if (shouldDrawHover())
 		{
 			float hoverAlpha = std::min(1.0f, _hoverFadeTime / 0.2f); // 0.2 second fade-in
-			drawToken(getTokenRectForCell(_hoverRow, _hoverCol), _game.getCurrentPlayer(), true, highlightCOL, 1.0f, hoverAlpha);
+			drawToken(getTokenRectForCell(_hoverRow, _hoverCol), _game->getCurrentPlayer(), true, highlightCOL, 1.0f, hoverAlpha);
 		}
 
 		if (!isHintFeatureEnabled())
 		{
 			_isHintActive = false;
 			_hintCol = -1;
+			_hintLine.clear();
 		}
 
 		// Draw hint target highlight with circular pulsing glow (balanced visibility)
-		if (_isHintActive && _hintCol >= 0 && _hintCol < ConnectFour::WIDTH)
+		if (_isHintActive && _hintCol >= 0 && _hintCol < _game->width())
 		{
 			auto now = std::chrono::steady_clock::now();
 			float hintElapsed = std::chrono::duration<float>(now - _hintStartTime).count();
 			if (hintElapsed <= 2.0f)
 			{
-				int hintRow = _game.getLowestEmptyRow(_hintCol);
+				// Expected continuation after the hinted move, as faded tokens numbered in order
+				for (size_t i = 0; i < _hintLine.size(); ++i)
+				{
+					const GhostToken& ghost = _hintLine[i];
+					const gui::Rect ghostRect = getTokenRectForCell(ghost.row, ghost.col);
+					drawToken(ghostRect, ghost.player, true, highlightCOL, 0.8f);
+					gui::Font ghostFont;
+					ghostFont.create(CONNECTXO_UI_FONT, std::max(1.0f, static_cast<float>(cell * 0.22)), gui::Font::Style::Bold, gui::Font::Unit::Point);
+					std::string number = std::to_string(i + 1);
+					gui::DrawableString::draw(td::String(number.c_str()), ghostRect, &ghostFont, td::ColorID::White, td::TextAlignment::Center, td::VAlignment::Center);
+				}
+
+				int hintRow = _game->getLowestEmptyRow(_hintCol);
 				if (hintRow >= 0)
 				{
 					double l = _boardLeft + _hintCol * cell;
@@ -416,6 +418,42 @@ protected:
 			else
 			{
 				_isHintActive = false;
+				_hintLine.clear();
+			}
+		}
+
+		// Column evaluation above the board: the background analysis of the human's options, as far
+		// as it got (proven win, proven loss, about as good as the best, worse)
+		updateAnalysis();
+		if (isHeatmapVisible() && static_cast<int>(_columnScores.size()) == cols)
+		{
+			int bestOpen = kNotAnalyzed;
+			for (int score : _columnScores)
+			{
+				if (score != kNotAnalyzed && std::abs(score) < 1000)
+					bestOpen = std::max(bestOpen, score);
+			}
+
+			const double barH = cell * 0.16;
+			const double barTop = _boardTop - cell * 0.28;
+			for (int c = 0; c < cols; ++c)
+			{
+				const int score = _columnScores[c];
+				if (score == kNotAnalyzed)
+					continue;
+				td::ColorID barColor = td::ColorID::Gainsboro;
+				if (score >= 1000)
+					barColor = winLine;
+				else if (score <= -1000)
+					barColor = loseLine;
+				else if (score >= bestOpen - kHeatmapMargin)
+					barColor = td::ColorID::Gold;
+
+				const double l = _boardLeft + c * cell;
+				gui::Rect barRect(l + cell * 0.1, barTop, l + cell * 0.9, barTop + barH);
+				gui::Shape shBar;
+				shBar.createRoundedRect(barRect, static_cast<td::Coord>(barH * 0.5), 1.0f);
+				shBar.drawFill(barColor);
 			}
 		}
 
@@ -536,13 +574,13 @@ protected:
 
 		// ROW 3: Counters
 		// Reset countersUpdated when a new game is in progress
-		if (!_game.isGameOver())
+		if (!_game->isGameOver())
 			_countersUpdated = false;
 
 		// If game over and counters not updated yet, update them
-		if (_game.isGameOver() && !_countersUpdated)
+		if (_game->isGameOver() && !_countersUpdated)
 		{
-			Player winner = _game.getWinner();
+			Player winner = _game->getWinner();
 			if (winner == _humanPlayer)
 			{
 				++_winCounter; // human wins
@@ -588,23 +626,15 @@ protected:
 		gui::DrawableString::draw(lossText, lossCounterRect, &counterFont, textLblColor, td::TextAlignment::Right, td::VAlignment::Center);
 
 		// ===== Game Over Overlay (Below Row 2 buttons) =====
-		if (_game.isGameOver())
+		if (_game->isGameOver())
 		{
 			// Draw winning line if applicable
-			auto winningLine = getWinningLine();
-			if (winningLine.size() == 4)
+			if (hasWinningLine)
 			{
-				int idx0 = winningLine.front();
-				int idx3 = winningLine.back();
-				int row0 = idx0 / ConnectFour::WIDTH;
-				int col0 = idx0 % ConnectFour::WIDTH;
-				int row3 = idx3 / ConnectFour::WIDTH;
-				int col3 = idx3 % ConnectFour::WIDTH;
-
-				double cx0 = _boardLeft + (col0 + 0.5) * cell;
-				double cy0 = _boardTop + (rows - 1 - row0 + 0.5) * cell;
-				double cx3 = _boardLeft + (col3 + 0.5) * cell;
-				double cy3 = _boardTop + (rows - 1 - row3 + 0.5) * cell;
+				double cx0 = _boardLeft + (lineCol0 + 0.5) * cell;
+				double cy0 = _boardTop + (rows - 1 - lineRow0 + 0.5) * cell;
+				double cx3 = _boardLeft + (lineCol1 + 0.5) * cell;
+				double cy3 = _boardTop + (rows - 1 - lineRow1 + 0.5) * cell;
 
 				double dx = cx3 - cx0;
 				double dy = cy3 - cy0;
@@ -626,7 +656,7 @@ protected:
 					ey = std::clamp(ey, _boardTop + margin, boardBottom - margin);
 
 					float winStroke = std::max(3.0f, static_cast<float>(cell * 0.12));
-					td::ColorID lineColor = (_game.getWinner() == _humanPlayer) ? winLine : loseLine;
+					td::ColorID lineColor = (_game->getWinner() == _humanPlayer) ? winLine : loseLine;
 					gui::Shape::drawLine(gui::Point(sx, sy), gui::Point(ex, ey), lineColor, winStroke);
 				}
 			}
@@ -635,17 +665,17 @@ protected:
 			gui::Rect overlayRect(rect.left + col1Width, row3Top, rect.left + 2.0 * col1Width, row3Top + row3Height);
 
 			td::String overlayLbl;
-			if (_game.getWinner() == _humanPlayer)
+			if (_game->getWinner() == _humanPlayer)
 				overlayLbl = tr("youWin");
-			else if (_game.getWinner() == _AIrole)
+			else if (_game->getWinner() == _AIrole)
 				overlayLbl = tr("youLose");
 			else
 				overlayLbl = tr("draw");
 
 			td::ColorID overlayTxtColor;
-			if (_game.getWinner() == _humanPlayer)
+			if (_game->getWinner() == _humanPlayer)
 				overlayTxtColor = winLine;
-			else if (_game.getWinner() == _AIrole)
+			else if (_game->getWinner() == _AIrole)
 				overlayTxtColor = loseLine;
 			else
 				overlayTxtColor = drawLine;
@@ -697,19 +727,19 @@ protected:
 
 		if (_cellSize <= 0)
 			return;
-		if (_game.isGameOver() || _aiMoveScheduled || _isFalling)
+		if (_game->isGameOver() || _aiMoveScheduled || _isFalling)
 		{
 			clearHover();
 			return;
 		}
-		if (_game.getCurrentPlayer() != _humanPlayer)
+		if (_game->getCurrentPlayer() != _humanPlayer)
 		{
 			clearHover();
 			return;
 		}
 
-		const bool inBoardX = (pt.x >= _boardLeft) && (pt.x <= _boardLeft + _cellSize * ConnectFour::WIDTH);
-		const bool inBoardY = (pt.y >= _boardTop) && (pt.y <= _boardTop + _cellSize * ConnectFour::HEIGHT);
+		const bool inBoardX = (pt.x >= _boardLeft) && (pt.x <= _boardLeft + _cellSize * _game->width());
+		const bool inBoardY = (pt.y >= _boardTop) && (pt.y <= _boardTop + _cellSize * _game->height());
 		if (!inBoardX || !inBoardY)
 		{
 			clearHover();
@@ -717,13 +747,13 @@ protected:
 		}
 
 		int col = static_cast<int>((pt.x - _boardLeft) / _cellSize);
-		if (col < 0 || col >= ConnectFour::WIDTH)
+		if (col < 0 || col >= _game->width())
 		{
 			clearHover();
 			return;
 		}
 
-		int row = _game.getLowestEmptyRow(col);
+		int row = _game->getLowestEmptyRow(col);
 		if (row < 0)
 		{
 			clearHover();
@@ -771,9 +801,14 @@ protected:
 			_countersUpdated = false;
 			_isHintActive = false;
 			_hintCol = -1;
-			// Invalidate any pending AI moves
+			_hintLine.clear();
+			// Invalidate any pending AI moves and end the search behind them
 			++_aiGen;
 			_aiMoveScheduled = false;
+			stopAISearch();
+			stopHint();
+			stopAnalysis();
+			stopPondering();
 			if (_onQuit)
 				_onQuit();
 			else
@@ -793,17 +828,25 @@ protected:
 			// Replay: keep counters, reset game board
 			++_aiGen; // Invalidate pending AI
 			_aiMoveScheduled = false;
+			_pendingAIMove = -1;
+			stopAISearch(); // the new game's search must not overlap the old one on _aiPlayer
+			stopHint();
+			stopAnalysis();
+			stopPondering();
+			clearPonderCache();
 			// Toggle human/AI roles before starting new game
 			_humanPlayer = (_humanPlayer == Player::X) ? Player::O : Player::X;
 			if (_humanPlayer == Player::X)
 				_AIrole = Player::O;
 			else if (_humanPlayer == Player::O)
 				_AIrole = Player::X;
-			// Start a new game with X always starting
-			_game.reset(Player::X);
+			// Start a new game with X always starting, on the board size picked in the settings
+			_game = makeConnectBoard(selectedBoard());
+			_game->reset(Player::X);
 			_countersUpdated = false;
 			_isHintActive = false;
 			_hintCol = -1;
+			_hintLine.clear();
 			_winPulseStartTime = std::chrono::steady_clock::now(); // Reset win pulse timer
 
 			// If AI now plays as X (i.e. human is O), schedule AI first move
@@ -811,22 +854,28 @@ protected:
 			{
 				_aiMoveScheduled = true;
 				int gen = ++_aiGen;
-				std::thread aiStartThread([this, gen]() {
-					std::this_thread::sleep_for(std::chrono::milliseconds(500));
-					Game::Move aiMove = _aiPlayer.chooseMove(_game, 12);
+				EngineConfig config = EngineConfig::forCurrentDifficulty(12); // snapshot on the UI thread
+				config.cancel = &_aiStop;
+				_aiStop = false;
+				std::shared_ptr<const ConnectBoard> start = _game->copy(); // a later replay may replace _game
+				_aiThread = std::thread([this, gen, config, start]() {
+					waitUnlessAIStopped(std::chrono::steady_clock::now() + std::chrono::milliseconds(500));
+					Game::Move aiMove = _aiStop ? -1 : _aiPlayer.chooseMove(*start, config);
 					auto* fn = new gui::AsyncFn([this, aiMove, gen]() {
-						if (gen == _aiGen)
+						if (gen != _aiGen)
+							return;
+						if (aiMove >= 0)
 						{
-							if (aiMove >= 0)
-							{
-								startFallingToken(aiMove, _game.getCurrentPlayer());
-							}
+							startFallingToken(aiMove, _game->getCurrentPlayer());
 						}
 						_aiMoveScheduled = false;
 						});
 					gui::NatObject::asyncCall(fn, true);
 					});
-				aiStartThread.detach();
+			}
+			else
+			{
+				startPondering();
 			}
 			reDraw();
 			return;
@@ -835,29 +884,26 @@ protected:
 		// Check Hint button
 		if (pointInRect(_hintBtn, pt))
 		{
-			if (isHintEnabled())
-			{
-				int bestMove = calculateOptimalHint();
-				if (bestMove >= 0 && bestMove < ConnectFour::WIDTH)
-				{
-					_hintCol = bestMove;
-					_isHintActive = true;
-					_hintStartTime = std::chrono::steady_clock::now();
-					reDraw();
-				}
-			}
+			if (isHintEnabled() && !_hintPending)
+				startHint();
 			return;
 		}
 
 		// Otherwise, handle board column selection (only if game is not over and it's human's turn)
-		if (_game.isGameOver() || _aiMoveScheduled || _isFalling) return;
-		if (_game.getCurrentPlayer() != _humanPlayer) return; // human's turn
+		if (_game->isGameOver() || _aiMoveScheduled || _isFalling) return;
+		if (_game->getCurrentPlayer() != _humanPlayer) return; // human's turn
 
 		int col = static_cast<int>((pt.x - _boardLeft) / _cellSize);
-		if (col < 0 || col >= ConnectFour::WIDTH) return;
-
-		if (!startFallingToken(col, _game.getCurrentPlayer()))
+		if (col < 0 || col >= _game->width()) return;
+
+		stopAnalysis();
+		stopPondering(); // the human has played; free the CPU for the real search
+		stopHint();
+		_isHintActive = false; // the ghost line no longer matches the board
+		_hintLine.clear();
+		if (!startFallingToken(col, _game->getCurrentPlayer()))
 			return;
+		scheduleAIMove(col);
 
 		clearHover();
 	}
@@ -878,12 +924,20 @@ private:
 		bool soundPlayed = false;  // Ensure click sound plays only once when token settles
 	};
 
+	// A move of the hint's expected continuation, drawn dimmed on its landing cell
+	struct GhostToken
+	{
+		int row;
+		int col;
+		Player player;
+	};
+
 	static constexpr double kTokenInsetScale = 0.12;
 
 	gui::Rect getTokenRectForCell(int row, int col) const
 	{
 		const double l = _boardLeft + col * _cellSize;
-		const double t = _boardTop + (ConnectFour::HEIGHT - 1 - row) * _cellSize;
+		const double t = _boardTop + (_game->height() - 1 - row) * _cellSize;
 		const double rgt = l + _cellSize;
 		const double b = t + _cellSize;
 		const double inset = _cellSize * kTokenInsetScale;
@@ -941,7 +995,7 @@ private:
 
 	bool shouldDrawHover() const
 	{
-		return !_isFalling && !_aiMoveScheduled && !_game.isGameOver() && _game.getCurrentPlayer() == _humanPlayer && _hoverCol >= 0 && _hoverRow >= 0;
+		return !_isFalling && !_aiMoveScheduled && !_game->isGameOver() && _game->getCurrentPlayer() == _humanPlayer && _hoverCol >= 0 && _hoverRow >= 0;
 	}
 
 	bool isHintFeatureEnabled() const
@@ -955,23 +1009,102 @@ private:
 		return props->getValue("showHint", 1) != 0;
 	}
 
+	// "showHint" = 2: hints plus the column evaluation bar
+	bool isHeatmapEnabled() const
+	{
+		const gui::Application* app = getApplication();
+		if (!app)
+			return false;
+		auto props = const_cast<gui::Application*>(app)->getProperties();
+		if (!props)
+			return false;
+		return props->getValue("showHint", 1) == 2;
+	}
+
+	bool isHeatmapVisible() const
+	{
+		return isHeatmapEnabled() && isHintEnabled();
+	}
+
+	// Board size from the settings ("c4Board"); read when a game starts, so a change applies to the next one
+	ConnectVariant selectedBoard() const
+	{
+		const gui::Application* app = getApplication();
+		if (!app)
+			return ConnectVariant::Classic;
+		auto props = const_cast<gui::Application*>(app)->getProperties();
+		if (!props)
+			return ConnectVariant::Classic;
+		return clampConnectVariant(props->getValue("c4Board", 0));
+	}
+
 	bool isHintEnabled() const
 	{
-		return isHintFeatureEnabled() && !_isFalling && !_aiMoveScheduled && !_game.isGameOver() && _game.getCurrentPlayer() == _humanPlayer;
+		return isHintFeatureEnabled() && !_isFalling && !_aiMoveScheduled && !_game->isGameOver() && _game->getCurrentPlayer() == _humanPlayer;
 	}
 
-	// Calculate optimal hint move using AI's minimax evaluation
-	int calculateOptimalHint()
+	// Searches the hint on its own thread within kHintBudgetMs, always at full strength (the hint is
+	// not weakened by the opponent's difficulty setting), and posts the move back; a result for a
+	// position that has changed since is ignored by generation
+	void startHint()
 	{
-		// Simply use the AI player's own best move calculation
-		// from the human player's perspective
-		const auto validMoves = _game.getValidMoves();
-		if (validMoves.empty())
-			return -1;
+		stopHint();
+		EngineConfig config = EngineConfig::fullStrength(8);
+		config.timeBudgetMs = kHintBudgetMs;
+		config.cancel = &_hintStop;
+
+		_hintStop = false;
+		_hintPending = true;
+		const int gen = ++_hintGen;
+		std::shared_ptr<const ConnectBoard> snapshot = _game->copy();
+		_hintThread = std::thread([this, snapshot, config, gen]() {
+			const SearchResult result = _hintPlayer.chooseMoveDetailed(*snapshot, config);
+			const Game::Move move = result.move;
+			const std::vector<GhostToken> line = hintContinuation(*snapshot, result.pv);
+			auto* fn = new gui::AsyncFn([this, move, line, gen]() {
+				if (gen != _hintGen)
+					return;
+				_hintPending = false;
+				if (move < 0 || move >= _game->width())
+					return;
+				_hintCol = move;
+				_hintLine = line;
+				_isHintActive = true;
+				_hintStartTime = std::chrono::steady_clock::now();
+				reDraw();
+				});
+			gui::NatObject::asyncCall(fn, true);
+			});
+	}
+
+	// Cancels a running hint search; its result, if already posted, is ignored by generation
+	void stopHint()
+	{
+		_hintStop = true;
+		if (_hintThread.joinable())
+			_hintThread.join();
+		++_hintGen;
+		_hintPending = false;
+	}
 
-		// Use AI engine to evaluate - it will find the best move
-		// using minimax with alpha-beta pruning at depth 8
-		return _aiPlayer.chooseMove(_game, 8);
+	// The moves after the hint in the search's principal variation, as ghost tokens
+	static std::vector<GhostToken> hintContinuation(const ConnectBoard& position, const std::vector<Game::Move>& pv)
+	{
+		std::vector<GhostToken> line;
+		auto board = position.copy();
+		for (size_t i = 0; i < pv.size() && i <= kHintLineLength; ++i)
+		{
+			const int col = pv[i];
+			const int row = board->getLowestEmptyRow(col);
+			const Player player = board->getCurrentPlayer();
+			if (row < 0 || !board->makeMove(col))
+				break;
+			if (i > 0)
+				line.push_back({ row, col, player });
+			if (board->isGameOver())
+				break;
+		}
+		return line;
 	}
 
 	void clearHover()
@@ -988,7 +1121,7 @@ private:
 	{
 		if (_cellSize <= 0)
 			return false;
-		int targetRow = _game.getLowestEmptyRow(col);
+		int targetRow = _game->getLowestEmptyRow(col);
 		if (targetRow < 0)
 			return false;
 
@@ -1003,7 +1136,7 @@ private:
 		_animTimeValid = false;
 		_fallingToken.startY = static_cast<float>(_boardTop - _cellSize);
 		_fallingToken.currentY = _fallingToken.startY;
-		_fallingToken.targetY = static_cast<float>(_boardTop + (ConnectFour::HEIGHT - 1 - targetRow) * _cellSize + _cellSize * kTokenInsetScale);
+		_fallingToken.targetY = static_cast<float>(_boardTop + (_game->height() - 1 - targetRow) * _cellSize + _cellSize * kTokenInsetScale);
 		{
 			const float distance = std::max(1.0f, _fallingToken.targetY - _fallingToken.startY);
 			const float base = static_cast<float>(_cellSize) * 10.0f;
@@ -1018,7 +1151,7 @@ private:
 
 	void updateFallingTarget(double cell)
 	{
-		_fallingToken.targetY = static_cast<float>(_boardTop + (ConnectFour::HEIGHT - 1 - _fallingToken.targetRow) * cell + cell * kTokenInsetScale);
+		_fallingToken.targetY = static_cast<float>(_boardTop + (_game->height() - 1 - _fallingToken.targetRow) * cell + cell * kTokenInsetScale);
 		if (_fallingToken.currentY < _boardTop - cell)
 			_fallingToken.currentY = static_cast<float>(_boardTop - cell);
 	}
@@ -1072,11 +1205,11 @@ private:
 		stopAnimation();
 
 		// Sound already played in animate() when token settled
-		_game.makeMove(_fallingToken.column);
+		_game->makeMove(_fallingToken.column);
 
-		if (_game.isGameOver() && !_countersUpdated)
+		if (_game->isGameOver() && !_countersUpdated)
 		{
-			Player winner = _game.getWinner();
+			Player winner = _game->getWinner();
 			if (winner == _humanPlayer)
 			{
 				++_winCounter;
@@ -1093,7 +1226,7 @@ private:
 		}
 
 		reDraw();
-		if (_game.isGameOver())
+		if (_game->isGameOver())
 		{
 			_aiMoveScheduled = false;
 			return;
@@ -1101,43 +1234,233 @@ private:
 
 		if (_fallingToken.type == _humanPlayer)
 		{
-			scheduleAIMove();
+			playPendingAIMove();
 			return;
 		}
 
 		_aiMoveScheduled = false;
+		startPondering();
 	}
 
-	void scheduleAIMove()
+	// Starts the AI's reply the moment the human picks a column, searching a snapshot that
+	// already contains that move while the human's token is still falling. The AI's token
+	// drops no sooner than kAIDisplayDelay after the human's token lands.
+	void scheduleAIMove(int humanCol)
 	{
+		std::shared_ptr<ConnectBoard> afterHuman = _game->copy();
+		if (!afterHuman->makeMove(humanCol) || afterHuman->isGameOver())
+			return;
+
+		stopAISearch(); // the previous reply has been played, so its thread is done or finishing
 		_aiMoveScheduled = true;
+		_pendingAIMove = -1;
 		int gen = ++_aiGen;
-		std::thread aiThread([this, gen]() {
-			std::this_thread::sleep_for(std::chrono::milliseconds(400));
-			Game::Move aiMove = _aiPlayer.chooseMove(_game, 10);
+		const auto landing = std::chrono::duration<float>(_fallingToken.dropDuration + _fallingToken.bounceDuration);
+		const auto notBefore = std::chrono::steady_clock::now()
+			+ std::chrono::duration_cast<std::chrono::steady_clock::duration>(landing) + kAIDisplayDelay;
+		const Game::Move pondered = takePonderedReply(*afterHuman); // skip the search if pondering already did it
+		EngineConfig config = EngineConfig::forCurrentDifficulty(10); // snapshot on the UI thread
+		config.cancel = &_aiStop;
+		_aiStop = false;
+		_aiThread = std::thread([this, gen, config, afterHuman, pondered, notBefore]() {
+			Game::Move aiMove = (pondered >= 0) ? pondered : _aiPlayer.chooseMove(*afterHuman, config);
+			waitUnlessAIStopped(notBefore);
 			auto* fn = new gui::AsyncFn([this, aiMove, gen]() {
 				if (gen != _aiGen)
+					return;
+				if (aiMove < 0)
 				{
 					_aiMoveScheduled = false;
 					return;
 				}
-				if (!_game.isGameOver() && aiMove >= 0)
+				_pendingAIMove = aiMove;
+				playPendingAIMove();
+				});
+			gui::NatObject::asyncCall(fn, true);
+			});
+	}
+
+	// Cancels the AI's search, if one is running, and joins its thread; a reply it has already
+	// posted is ignored by generation
+	void stopAISearch()
+	{
+		_aiStop = true;
+		if (_aiThread.joinable())
+			_aiThread.join();
+	}
+
+	// On the AI thread: sleeps until the given time, or less once stopAISearch() is called
+	void waitUnlessAIStopped(std::chrono::steady_clock::time_point until) const
+	{
+		for (auto now = std::chrono::steady_clock::now(); now < until && !_aiStop; now = std::chrono::steady_clock::now())
+			std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(until - now, std::chrono::milliseconds(10)));
+	}
+
+	// Drops the AI's searched reply once the human's token has landed; if it is still
+	// falling, finalizeFallingToken() calls this again.
+	void playPendingAIMove()
+	{
+		if (_isFalling || _pendingAIMove < 0)
+			return;
+		const Game::Move aiMove = _pendingAIMove;
+		_pendingAIMove = -1;
+		if (_game->isGameOver() || !startFallingToken(aiMove, _game->getCurrentPlayer()))
+			_aiMoveScheduled = false;
+	}
+
+	// Pondering: while the human thinks, search the AI's reply to each of their
+	// legal moves on a background thread and cache the results for this game.
+	void startPondering()
+	{
+		stopPondering();
+		if (_game->isGameOver() || _game->getCurrentPlayer() != _humanPlayer)
+			return;
+
+		EngineConfig config = EngineConfig::forCurrentDifficulty(10); // same search scheduleAIMove would run
+		config.cancel = &_ponderStop;
+		{
+			std::lock_guard<std::mutex> lock(_ponderMutex);
+			if (_ponderDifficulty != getAIDifficultyIndex())
+				_ponderCache.clear();
+			_ponderDifficulty = getAIDifficultyIndex();
+		}
+
+		_ponderStop = false;
+		std::shared_ptr<const ConnectBoard> snapshot = _game->copy();
+		_ponderThread = std::thread([this, snapshot, config]() {
+			for (int i = 0; i < snapshot->width(); ++i)
+			{
+				const int col = snapshot->columnOrder()[i]; // likeliest human moves first
+				if (_ponderStop)
+					return;
+				auto afterHuman = snapshot->copy();
+				if (!afterHuman->makeMove(col) || afterHuman->isGameOver())
+					continue;
+
+				const auto start = std::chrono::steady_clock::now();
+				const Game::Move reply = _ponderPlayer.chooseMove(*afterHuman, config);
+				const auto spent = std::chrono::steady_clock::now() - start;
+				if (_ponderStop)
+					return; // search was cut short, don't cache a partial result
 				{
-					if (!startFallingToken(aiMove, _game.getCurrentPlayer()))
-						_aiMoveScheduled = false;
+					std::lock_guard<std::mutex> lock(_ponderMutex);
+					_ponderCache[afterHuman->getKey()] = reply;
 				}
-				else
+
+				idleForCpuShare(spent, kPonderCpuShare, _ponderStop);
+			}
+			});
+	}
+
+	// Stays under a background search's CPU cap by idling in proportion to the time just spent
+	// searching; returns early once stop is set.
+	static void idleForCpuShare(std::chrono::steady_clock::duration spent, double share, const std::atomic<bool>& stop)
+	{
+		auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(spent * ((1.0 - share) / share));
+		while (idle.count() > 0 && !stop)
+		{
+			const auto slice = std::min(idle, std::chrono::milliseconds(10));
+			std::this_thread::sleep_for(slice);
+			idle -= slice;
+		}
+	}
+
+	// Called on every frame: keeps the column evaluation's analysis on the position the human is
+	// looking at, and stops it while the bar is hidden.
+	void updateAnalysis()
+	{
+		if (!isHeatmapVisible())
+		{
+			if (_analysisActive)
+				stopAnalysis();
+			return;
+		}
+		if (_analysisActive && _analysisKey == _game->getKey())
+			return;
+		startAnalysis();
+	}
+
+	// Multi-PV analysis of every column on a snapshot. Each completed depth is posted to the UI
+	// thread; the search pauses between short slices of work to stay at kAnalysisCpuShare of one core.
+	void startAnalysis()
+	{
+		stopAnalysis();
+		const int emptyCells = _game->width() * _game->height() - _game->stoneCount();
+		EngineConfig config = EngineConfig::fullStrength(std::min(kAnalysisMaxDepth, emptyCells));
+		config.threads = 1;
+		config.cancel = &_analysisStop;
+		config.cpuShare = kAnalysisCpuShare; // the search itself pauses between slices of work
+
+		_analysisStop = false;
+		_analysisActive = true;
+		_analysisKey = _game->getKey();
+		const int gen = ++_analysisGen;
+		std::shared_ptr<const ConnectBoard> snapshot = _game->copy();
+		_analysisThread = std::thread([this, snapshot, config, gen]() {
+			_analysisPlayer.analyze(*snapshot, config, 0, [&](const Analysis& analysis) {
+				std::vector<int> scores(snapshot->width(), kNotAnalyzed);
+				for (const MoveAnalysis& line : analysis.moves)
 				{
-					_aiMoveScheduled = false;
+					if (line.depth > 0 && line.move >= 0 && line.move < snapshot->width())
+						scores[line.move] = line.score;
 				}
+				auto* fn = new gui::AsyncFn([this, scores, gen]() {
+					if (gen != _analysisGen)
+						return;
+					_columnScores = scores;
+					reDraw();
+					});
+				gui::NatObject::asyncCall(fn, true);
 				});
-			gui::NatObject::asyncCall(fn, true);
 			});
-		aiThread.detach();
 	}
 
-	ConnectFour _game;
+	// Cancels the analysis (if any) and drops its results; pending updates are ignored by generation
+	void stopAnalysis()
+	{
+		_analysisStop = true;
+		if (_analysisThread.joinable())
+			_analysisThread.join();
+		++_analysisGen;
+		_analysisActive = false;
+		_columnScores.clear();
+	}
+
+	void saveTableSnapshot()
+	{
+		if (!_tableSnapshotPath.empty())
+			_aiPlayer.saveTable(_tableSnapshotPath);
+	}
+
+	void stopPondering()
+	{
+		_ponderStop = true;
+		if (_ponderThread.joinable())
+			_ponderThread.join();
+	}
+
+	void clearPonderCache()
+	{
+		std::lock_guard<std::mutex> lock(_ponderMutex);
+		_ponderCache.clear();
+	}
+
+	// Returns the pondered reply for the given position, or -1 on a miss
+	Game::Move takePonderedReply(const ConnectBoard& position)
+	{
+		std::lock_guard<std::mutex> lock(_ponderMutex);
+		if (_ponderDifficulty != getAIDifficultyIndex())
+			return -1; // difficulty changed since the cache was filled
+		auto it = _ponderCache.find(position.getKey());
+		if (it == _ponderCache.end() || position.getLowestEmptyRow(it->second) < 0)
+			return -1;
+		return it->second;
+	}
+
+	std::unique_ptr<ConnectBoard> _game;
 	AIPlayer _aiPlayer;
+	AIPlayer _hintPlayer; // separate engine so a hint never shares state with the AI's search
+	AIPlayer _ponderPlayer;
 	bool _playSound = true;
 	gui::Image _imgToken1;
 	gui::Image _imgToken2;
@@ -1166,6 +1489,12 @@ private:
 
 	// AI generation counter to invalidate pending AI moves when resetting/closing
 	int _aiGen;
+	std::thread _aiThread;              // the AI's current search; one at a time on _aiPlayer
+	std::atomic<bool> _aiStop{ true };  // cancels it (EngineConfig::cancel)
+
+	// AI reply searched ahead of the human's token landing (-1 = none yet)
+	static constexpr std::chrono::milliseconds kAIDisplayDelay{ 400 };
+	Game::Move _pendingAIMove = -1;
 
 	// Current human player, toggles between X and O
 	Player _humanPlayer;
@@ -1180,7 +1509,14 @@ private:
 	// Hint system
 	bool _isHintActive = false;
 	int _hintCol = -1;
+	static constexpr size_t kHintLineLength = 4; // moves of the expected continuation shown after the hint
+	std::vector<GhostToken> _hintLine;
 	std::chrono::steady_clock::time_point _hintStartTime;
+	static constexpr int kHintBudgetMs = 300; // shared by the proof and alpha-beta searches
+	std::thread _hintThread;
+	std::atomic<bool> _hintStop{ true };
+	int _hintGen = 0;
+	bool _hintPending = false; // a hint search is running; the button ignores clicks meanwhile
 
 	// Hover fade animation
 	float _hoverFadeTime = 0.0f;
@@ -1191,4 +1527,28 @@ private:
 	// Hint button
 	gui::Rect _hintBtn;
 	bool _hintBtnHovered = false;
+
+	// Pondering on the human's time; the cache maps position keys to the AI's reply
+	static constexpr double kPonderCpuShare = 0.5; // fraction of one core pondering may use
+	std::thread _ponderThread;
+	std::atomic<bool> _ponderStop{ true };
+	std::mutex _ponderMutex;
+	std::unordered_map<std::uint64_t, Game::Move> _ponderCache;
+	int _ponderDifficulty = -1;
+
+	// Column evaluation, fed by a throttled multi-PV analysis while the human thinks
+	static constexpr double kAnalysisCpuShare = 0.25; // fraction of one core the analysis may use
+	static constexpr int kAnalysisMaxDepth = 16;
+	static constexpr int kHeatmapMargin = 25; // undecided columns this close to the best are marked good
+	static constexpr int kNotAnalyzed = std::numeric_limits<int>::min();
+	AIPlayer _analysisPlayer;
+	std::thread _analysisThread;
+	std::atomic<bool> _analysisStop{ true };
+	int _analysisGen = 0;
+	bool _analysisActive = false;
+	std::uint64_t _analysisKey = 0; // position being analyzed
+	std::vector<int> _columnScores; // per column, human's point of view; kNotAnalyzed until searched
+
+	// AI transposition table snapshot in the app data directory (empty = not persisted)
+	std::string _tableSnapshotPath;
 };
\ No newline at end of file
@@ -1,116 +1,440 @@
 #pragma once
 #include "AIPlayer.h"
 #include <array>
+#include <cstdint>
+#include <memory>
 #include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
-class ConnectFour : public Game
+// Fixed-size bitset of Words 64-bit words with the logic and shift operations the line kernels
+// need. With one word every operation is plain uint64_t arithmetic.
+template <int Words>
+struct WideBits
+{
+ std::uint64_t w[Words] = {};
+
+ constexpr bool test(int bit) const { return (w[bit >>6] >> (bit &63)) &1; }
+ constexpr void set(int bit) { w[bit >>6] |= std::uint64_t(1) << (bit &63); }
+
+ // Bits len (< 64) wide starting at bit, which may straddle two words.
+ constexpr std::uint64_t field(int bit, int len) const
+ {
+ const int word = bit >>6;
+ const int offset = bit &63;
+ std::uint64_t v = w[word] >> offset;
+ if (offset + len >64 && word +1 < Words) v |= w[word +1] << (64 - offset);
+ return v & ((std::uint64_t(1) << len) -1);
+ }
+
+ // Bit i of the result is bit i + n of this (n < 0 shifts towards the top); bits shifted in are 0.
+ constexpr WideBits shifted(int n) const
+ {
+ WideBits r;
+ if (Words ==1)
+ {
+ if (n >=0) r.w[0] = (n <64) ? (w[0] >> n) :0;
+ else r.w[0] = (-n <64) ? (w[0] << -n) :0;
+ return r;
+ }
+ const int words = (n >=0 ? n : -n) >>6;
+ const int bits = (n >=0 ? n : -n) &63;
+ for (int i =0; i < Words; ++i)
+ {
+ if (n >=0)
+ {
+ const int src = i + words;
+ if (src < Words) r.w[i] = w[src] >> bits;
+ if (bits && src +1 < Words) r.w[i] |= w[src +1] << (64 - bits);
+ }
+ else
+ {
+ const int src = i - words;
+ if (src >=0) r.w[i] = w[src] << bits;
+ if (bits && src -1 >=0) r.w[i] |= w[src -1] >> (64 - bits);
+ }
+ }
+ return r;
+ }
+
+ constexpr WideBits operator&(const WideBits& o) const { WideBits r; for (int i =0; i < Words; ++i) r.w[i] = w[i] & o.w[i]; return r; }
+ constexpr WideBits operator|(const WideBits& o) const { WideBits r; for (int i =0; i < Words; ++i) r.w[i] = w[i] | o.w[i]; return r; }
+ constexpr WideBits operator~() const { WideBits r; for (int i =0; i < Words; ++i) r.w[i] = ~w[i]; return r; }
+
+ bool any() const
+ {
+ std::uint64_t v =0;
+ for (int i =0; i < Words; ++i) v |= w[i];
+ return v !=0;
+ }
+
+ int count() const
+ {
+ int n =0;
+ for (int i =0; i < Words; ++i)
+ {
+#if defined(_MSC_VER) && defined(_M_X64)
+ n += static_cast<int>(__popcnt64(w[i]));
+#elif defined(__GNUC__) || defined(__clang__)
+ n += __builtin_popcountll(w[i]);
+#else
+ for (std::uint64_t v = w[i]; v; v &= v -1) ++n;
+#endif
+ }
+ return n;
+ }
+
+ // Cells of columns [firstCol, lastCol] in a layout of stride bits per column, rows below height.
+ static constexpr WideBits columns(int stride, int height, int firstCol, int lastCol)
+ {
+ WideBits r;
+ for (int col = firstCol; col <= lastCol; ++col)
+ for (int row =0; row < height; ++row)
+ r.set(col * stride + row);
+ return r;
+ }
+};
+
+// Columns by distance from the center, the left one first on ties: 3,2,4,1,5,0,6 for 7 wide.
+template <int W>
+constexpr std::array<int, W> centerFirstColumns()
+{
+ std::array<int, W> order{};
+ int n =0;
+ for (int dist =0; dist <= W; ++dist)
+ for (int col =0; col < W; ++col)
+ {
+ const int twice = 2 * col - (W -1);
+ if (twice == -dist || (dist >0 && twice == dist)) order[n++] = col;
+ }
+ return order;
+}
+
+// Board-size independent side of a drop-token game, so the engine and the view handle every
+// ConnectN instantiation through one type.
+class ConnectBoard : public Game
 {
 public:
- static constexpr int WIDTH =7;
- static constexpr int HEIGHT =6;
+ virtual int width() const =0;
+ virtual int height() const =0;
+ virtual int runLength() const =0;
+
+ // row0 is the bottom row; row increases upwards to height()-1
+ virtual Player getCell(int row, int col) const =0;
+ // Returns lowest empty row for a column, or -1 if column is full/invalid.
+ virtual int getLowestEmptyRow(int col) const =0;
+ virtual int stoneCount() const =0;
+
+ // All columns, center first; the search and the ponderer try moves in this order.
+ virtual const int* columnOrder() const =0;
+
+ // The completed run, recorded by the move that made it: whether a cell is on it and its two end
+ // cells. winningLineEnds returns false while nobody has won.
+ virtual bool isOnWinningLine(int row, int col) const =0;
+ virtual bool winningLineEnds(int& fromRow, int& fromCol, int& toRow, int& toCol) const =0;
+ // Empty cells (playable now or not) where player's stone would complete a run; computed once per
+ // position on the first query.
+ virtual bool isThreatCell(Player player, int row, int col) const =0;
+
+ // Static score of a running game from aiPlayer's point of view (runs, open pairs, center).
+ virtual int evaluate(Player aiPlayer) const =0;
+
+ std::unique_ptr<ConnectBoard> copy() const
+ {
+ return std::unique_ptr<ConnectBoard>(static_cast<ConnectBoard*>(clone().release()));
+ }
+};
+
+// Connect-K on a W x H board. Each player's stones live in a bitboard of W columns of H+1 bits;
+// the spare bit on top of every column stops lines wrapping into the next one. Boards up to 64 bits
+// use a single word, larger ones a multi-word bitboard. Direction shifts, masks and the column
+// order are computed at compile time per instantiation.
+template <int W, int H, int K>
+class ConnectN : public ConnectBoard
+{
+ static_assert(K >=4 && (K <= W || K <= H), "runs of at least four that fit on the board");
+ static_assert(H <32, "a column must fit in a 32-bit field");
+
+ static constexpr int kStride = H +1;
+ static constexpr int kBits = W * kStride;
+
+public:
+ // Bit col * (H+1) + row per cell, as in the stone bitboards
+ using Bits = WideBits<(kBits +63) /64>;
+
+ static constexpr int WIDTH = W;
+ static constexpr int HEIGHT = H;
+ static constexpr int RUN = K;
  static constexpr int CELLS = WIDTH * HEIGHT;
 
- ConnectFour() { clearBoard(); }
+ ConnectN() { clearBoard(); }
 
  std::unique_ptr<Game> clone() const override
  {
- auto copy = std::make_unique<ConnectFour>();
- copy->_board = _board;
- copy->_currentPlayer = _currentPlayer;
- copy->_winner = _winner;
- copy->_gameOver = _gameOver;
- return copy;
+ return std::make_unique<ConnectN>(*this);
  }
 
+ int width() const override { return W; }
+ int height() const override { return H; }
+ int runLength() const override { return K; }
+ int stoneCount() const override { return _stoneCount; }
+ const int* columnOrder() const override { return kColumnOrder.data(); }
+
  std::vector<Move> getValidMoves() const override
  {
  std::vector<Move> moves;
  for (int col =0; col < WIDTH; ++col)
  {
- // top cell (highest row) empty means column can accept a token
- if (_board[index(HEIGHT -1, col)] == Player::None)
+ // a column below HEIGHT stones can accept a token
+ if (_heights[col] < HEIGHT)
  moves.push_back(col);
  }
  return moves;
  }
 
- Player checkWin() const override
+ // The run is found once, by placeMove, when the mover's stones first contain one.
+ Player checkWin() const override { return _lineWinner; }
+
+ bool isDraw() const override
+ {
+ return _stoneCount == CELLS;
+ }
+
+ Player getCell(int row, int col) const override
  {
- // Scan entire board for any4-in-a-row starting at each occupied cell.
- for (int row =0; row < HEIGHT; ++row)
+ if (!inBounds(row, col)) return Player::None;
+ const int bit = col * kStride + row;
+ if (_stones[0].test(bit)) return Player::X;
+ if (_stones[1].test(bit)) return Player::O;
+ return Player::None;
+ }
+
+ int getLowestEmptyRow(int col) const override
  {
- for (int col =0; col < WIDTH; ++col)
+ if (col < 0 || col >= WIDTH)
+ return -1;
+ return _heights[col] < HEIGHT ? _heights[col] : -1;
+ }
+
+ // Cells of the completed run (the whole run if it is longer than K), empty while nobody has won
+ const Bits& winningLine() const { return _winningLine; }
+
+ // Empty cells where player would complete a run, cached until the board changes
+ const Bits& threatCells(Player player) const
+ {
+ if (!_threatsValid)
  {
- Player p = _board[index(row, col)];
- if (p == Player::None) continue;
+ const Bits empty = kBoardMask & ~(_stones[0] | _stones[1]);
+ _threats[0] = threatsOf(_stones[0], empty);
+ _threats[1] = threatsOf(_stones[1], empty);
+ _threatsValid = true;
+ }
+ return _threats[player == Player::X ?0 :1];
+ }
 
- // horizontal (right)
- if (col +3 < WIDTH)
+ bool isOnWinningLine(int row, int col) const override
  {
- bool ok = true;
- for (int k =1; k <4; ++k)
- if (_board[index(row, col + k)] != p) { ok = false; break; }
- if (ok) return p;
+ return inBounds(row, col) && _winningLine.test(col * kStride + row);
  }
 
- // vertical (up)
- if (row +3 < HEIGHT)
+ bool winningLineEnds(int& fromRow, int& fromCol, int& toRow, int& toCol) const override
  {
- bool ok = true;
- for (int k =1; k <4; ++k)
- if (_board[index(row + k, col)] != p) { ok = false; break; }
- if (ok) return p;
+ if (_lineWinner == Player::None) return false;
+ fromRow = _lineEnds[0] % kStride;
+ fromCol = _lineEnds[0] / kStride;
+ toRow = _lineEnds[1] % kStride;
+ toCol = _lineEnds[1] / kStride;
+ return true;
  }
 
- // diagonal up-right
- if (col +3 < WIDTH && row +3 < HEIGHT)
+ bool isThreatCell(Player player, int row, int col) const override
  {
- bool ok = true;
- for (int k =1; k <4; ++k)
- if (_board[index(row + k, col + k)] != p) { ok = false; break; }
- if (ok) return p;
+ return player != Player::None && inBounds(row, col) && threatCells(player).test(col * kStride + row);
  }
 
- // diagonal up-left
- if (col -3 >=0 && row +3 < HEIGHT)
+ // The standard 7x6 board keys by its packed layout: for each column (HEIGHT+1 bits, column-major)
+ // the stones of the player to move plus the column's filled cells. Unique for every position;
+ // X moves first. Other sizes hash that layout with their dimensions and set bit 62, so no two
+ // board sizes (nor the tablebase, nor TicTacToe's bit 63 keys) share an entry.
+ std::uint64_t getKey() const override
  {
- bool ok = true;
- for (int k =1; k <4; ++k)
- if (_board[index(row + k, col - k)] != p) { ok = false; break; }
- if (ok) return p;
+ if constexpr (kPackedKey)
+ {
+ // Side to move by stone parity (also well defined once the game is over)
+ const Bits& mover = _stones[_stoneCount %2];
+ return mover.w[0] + (_stones[0] | _stones[1]).w[0];
  }
+ else
+ return hashedKey(false);
  }
+
+ // Counts the player's stones through the cell the move would fill, walking the bitboard.
+ bool isWinningMove(Player player, Move move) const override
+ {
+ const int row = getLowestEmptyRow(move);
+ if (row <0) return false;
+ const Bits& stones = _stones[player == Player::X ?0 :1];
+ const int bit = move * kStride + row;
+ for (int d : kShifts)
+ {
+ int count =1;
+ for (int b = bit + d; b < kBits && stones.test(b); b += d) ++count;
+ for (int b = bit - d; b >=0 && stones.test(b); b -= d) ++count;
+ if (count >= K) return true;
  }
- return Player::None;
+ return false;
  }
 
- bool isDraw() const override
+ // Random game to the end on copies of the bitboards, much cheaper than makeMove.
+ Player randomPlayout(std::mt19937& rng) const override
  {
- // If any top cell is empty, not a draw
+ if (_gameOver) return _winner;
+ Bits stones[2]; // [0] = player to move
+ stones[0] = _stones[_currentPlayer == Player::X ?0 :1];
+ stones[1] = _stones[_currentPlayer == Player::X ?1 :0];
+ std::array<int, W> heights = _heights;
+
+ const Player other = (_currentPlayer == Player::X) ? Player::O : Player::X;
+ for (int side =0;; side ^=1)
+ {
+ int cols[WIDTH];
+ int count =0;
  for (int col =0; col < WIDTH; ++col)
- if (_board[index(HEIGHT -1, col)] == Player::None)
- return false;
- return true;
+ if (heights[col] < HEIGHT) cols[count++] = col;
+ if (count ==0) return Player::None;
+ const int col = cols[rng() % count];
+ stones[side].set(col * kStride + heights[col]++);
+ if (hasAlignment(stones[side])) return side ==0 ? _currentPlayer : other;
+ }
  }
 
- // row0 is the bottom row; row increases upwards to HEIGHT-1
- Player getCell(int row, int col) const
+ // Left/right mirror of a packed key: every column is an independent HEIGHT+1 bit group.
+ static std::uint64_t mirrorKey(std::uint64_t key)
  {
- if (!inBounds(row, col)) return Player::None;
- return _board[index(row, col)];
+ static_assert(kBits <=64, "packed keys need a single-word board");
+ const std::uint64_t columnMask = (std::uint64_t(1) << kStride) -1;
+ std::uint64_t mirrored =0;
+ for (int col =0; col < WIDTH; ++col)
+ mirrored |= ((key >> (col * kStride)) & columnMask) << ((WIDTH -1 - col) * kStride);
+ return mirrored;
  }
 
- // Returns lowest empty row for a column, or -1 if column is full/invalid.
- int getLowestEmptyRow(int col) const
+ // The smaller of the key and its mirror; symmetry is 1 when the mirror was taken.
+ std::uint64_t getCanonicalKey(int& symmetry) const override
  {
- if (col < 0 || col >= WIDTH)
- return -1;
- for (int row = 0; row < HEIGHT; ++row)
+ const std::uint64_t key = getKey();
+ std::uint64_t mirrored;
+ if constexpr (kPackedKey)
+ mirrored = mirrorKey(key);
+ else
+ mirrored = hashedKey(true);
+ symmetry = (mirrored < key) ?1 :0;
+ return symmetry ? mirrored : key;
+ }
+
+ Move toCanonicalMove(Move move, int symmetry) const override
  {
- if (_board[index(row, col)] == Player::None)
- return row;
+ return (symmetry && move >=0) ? WIDTH -1 - move : move;
  }
- return -1;
+
+ Move fromCanonicalMove(Move move, int symmetry) const override
+ {
+ return toCanonicalMove(move, symmetry); // the mirror is its own inverse
+ }
+
+ // Number of stones in a packed (or mirrored) key, or -1 if it is not a key of this board.
+ static int stonesOfKey(std::uint64_t key)
+ {
+ static_assert(kBits <64, "packed keys need spare bits above the board");
+ if (key >> kBits) return -1;
+ int stones =0;
+ for (int col =0; col < WIDTH; ++col)
+ {
+ // column value = (2^h - 1) + moverBits, so h is the index of the top bit of value + 1
+ std::uint64_t v = ((key >> (col * kStride)) & ((std::uint64_t(1) << kStride) -1)) +1;
+ while (v >>= 1) ++stones;
+ }
+ return stones;
+ }
+
+ // Rebuilds the board from a packed key. Returns false (board unchanged) if the key is not a
+ // reachable stone layout.
+ bool setFromKey(std::uint64_t key)
+ {
+ static_assert(kBits <64, "packed keys need spare bits above the board");
+ if (key >> kBits) return false;
+ int stones =0;
+ int moverStones =0;
+ std::uint64_t moverBits[WIDTH] = {};
+ std::array<int, W> heights{};
+ for (int col =0; col < WIDTH; ++col)
+ {
+ // column value = (2^h - 1) + moverBits, moverBits < 2^h
+ const std::uint64_t v = ((key >> (col * kStride)) & ((std::uint64_t(1) << kStride) -1)) +1;
+ int h =0;
+ while ((std::uint64_t(2) << h) <= v) ++h;
+ if (h > HEIGHT) return false;
+ heights[col] = h;
+ moverBits[col] = v - (std::uint64_t(1) << h);
+ stones += h;
+ for (int row =0; row < h; ++row)
+ if (moverBits[col] & (std::uint64_t(1) << row)) ++moverStones;
+ }
+
+ // X moves first, so the side to move has exactly half of the stones (rounded down)
+ const int mover = stones %2; // 0 = X
+ if (moverStones != stones /2) return false;
+ Bits board[2];
+ for (int col =0; col < WIDTH; ++col)
+ for (int row =0; row < heights[col]; ++row)
+ board[(moverBits[col] & (std::uint64_t(1) << row)) ? mover : mover ^1].set(col * kStride + row);
+
+ _stones[0] = board[0];
+ _stones[1] = board[1];
+ _heights = heights;
+ _stoneCount = stones;
+ _currentPlayer = mover ==0 ? Player::X : Player::O;
+ clearLine();
+ _threatsValid = false;
+ // No single last move here, so look for a run only when the side has one at all
+ for (int side =0; side <2 && _lineWinner == Player::None; ++side)
+ {
+ if (!hasAlignment(_stones[side])) continue;
+ for (int bit =0; bit < kBits; ++bit)
+ if (_stones[side].test(bit) && recordLine(side, bit)) break;
+ }
+ _winner = checkWin();
+ _gameOver = (_winner != Player::None) || isDraw();
+ return true;
+ }
+
+ // Runs of K-1 score 50 and two in a row with an empty cell after them 10, per player; one
+ // bitboard pass per direction. Center column stones add 2.
+ int evaluate(Player aiPlayer) const override
+ {
+ const Bits empty = kBoardMask & ~(_stones[0] | _stones[1]);
+ const int ai = (aiPlayer == Player::X) ?0 :1;
+ int score =0;
+ for (int side =0; side <2; ++side)
+ {
+ const Bits& s = _stones[side];
+ int own =0;
+ for (const Direction& d : kEvalDirections)
+ {
+ if (d.runs)
+ {
+ Bits run = s;
+ for (int k =1; k < K -1; ++k)
+ run = run & s.shifted(k * d.offset);
+ own += 50 * run.count();
+ }
+ own += 10 * (s & s.shifted(d.offset) & empty.shifted(2 * d.offset)).count();
+ }
+ own += 2 * (s & kCenterMask).count();
+ score += (side == ai) ? own : -own;
+ }
+ return score;
  }
 
 protected:
@@ -118,25 +442,158 @@ protected:
  bool placeMove(Player player, Move move) override
  {
  if (move <0 || move >= WIDTH) return false;
- for (int row =0; row < HEIGHT; ++row)
+ if (_heights[move] >= HEIGHT) return false; // column full
+ const int side = player == Player::X ?0 :1;
+ const int bit = move * kStride + _heights[move]++;
+ _stones[side].set(bit);
+ ++_stoneCount;
+ _threatsValid = false;
+ // Only the mover can have made a run, and only through the new stone
+ if (_lineWinner == Player::None && hasAlignment(_stones[side])) recordLine(side, bit);
+ return true;
+ }
+
+ void clearBoard() override
+ {
+ _stones[0] = Bits();
+ _stones[1] = Bits();
+ _heights.fill(0);
+ _stoneCount =0;
+ _threatsValid = false;
+ clearLine();
+ }
+
+private:
+ static constexpr bool kPackedKey = (W ==7 && H ==6 && K ==4);
+
+ // Bit offsets between neighbours: vertical, horizontal and the two diagonals
+ static constexpr int kShifts[4] = {1, kStride, kStride +1, kStride -1};
+
+ // Evaluator directions from each stone: right, left (pairs only), up, up-right, up-left
+ struct Direction { int offset; bool runs; };
+ static constexpr Direction kEvalDirections[5] = {
+ {kStride, true}, {-kStride, false}, {1, true}, {kStride +1, true}, {1 - kStride, true} };
+
+ static constexpr Bits kBoardMask = Bits::columns(kStride, HEIGHT,0, WIDTH -1);
+ static constexpr Bits kCenterMask = Bits::columns(kStride, HEIGHT, (WIDTH -1) /2, WIDTH /2);
+
+ static constexpr std::array<int, W> kColumnOrder = centerFirstColumns<W>();
+
+ // K in a row: runs of length len double until the next doubling would overshoot K.
+ static bool hasAlignment(const Bits& stones)
  {
- if (_board[index(row, move)] == Player::None)
+ for (int d : kShifts)
  {
- _board[index(row, move)] = player;
+ Bits run = stones;
+ int len =1;
+ while (len *2 <= K)
+ {
+ run = run & run.shifted(len * d);
+ len *=2;
+ }
+ if (len < K) run = run & run.shifted((K - len) * d);
+ if (run.any()) return true;
+ }
+ return false;
+ }
+
+ // Walks out from the stone at bit in every direction; a run of K or more becomes the winning line.
+ bool recordLine(int side, int bit)
+ {
+ const Bits& stones = _stones[side];
+ for (int d : kShifts)
+ {
+ int from = bit, to = bit;
+ while (from - d >=0 && stones.test(from - d)) from -= d;
+ while (to + d < kBits && stones.test(to + d)) to += d;
+ if ((to - from) / d +1 < K) continue;
+ for (int b = from; b <= to; b += d) _winningLine.set(b);
+ _lineEnds[0] = from;
+ _lineEnds[1] = to;
+ _lineWinner = side ==0 ? Player::X : Player::O;
  return true;
  }
+ return false;
  }
- return false; // column full
+
+ void clearLine()
+ {
+ _winningLine = Bits();
+ _lineEnds[0] = _lineEnds[1] = -1;
+ _lineWinner = Player::None;
  }
 
- void clearBoard() override
+ // Cells of empty that complete K in a row: for every direction and every place i of the empty
+ // cell in the run, the other K-1 stones shifted onto it.
+ static Bits threatsOf(const Bits& stones, const Bits& empty)
+ {
+ Bits threats;
+ for (int d : kShifts)
+ for (int i =0; i < K; ++i)
  {
- _board.fill(Player::None);
+ Bits cells = empty;
+ for (int j =0; j < K; ++j)
+ if (j != i) cells = cells & stones.shifted((j - i) * d);
+ threats = threats | cells;
+ }
+ return threats;
  }
 
-private:
- std::array<Player, CELLS> _board;
+ std::uint64_t hashedKey(bool mirrored) const
+ {
+ const Bits& mover = _stones[_stoneCount %2];
+ std::uint64_t h = 0x9E3779B97F4A7C15ull * static_cast<std::uint64_t>(W *4096 + H *64 + K);
+ for (int i =0; i < WIDTH; ++i)
+ {
+ const int col = mirrored ? WIDTH -1 - i : i;
+ const std::uint64_t column = mover.field(col * kStride, HEIGHT) + ((std::uint64_t(1) << _heights[col]) -1);
+ h ^= column + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+ h ^= h >> 31;
+ h *= 0xBF58476D1CE4E5B9ull;
+ }
+ h ^= h >> 29;
+ return (h & ~(std::uint64_t(3) << 62)) | (std::uint64_t(1) << 62);
+ }
 
- inline int index(int row, int col) const { return row * WIDTH + col; }
  inline bool inBounds(int row, int col) const { return row >=0 && row < HEIGHT && col >=0 && col < WIDTH; }
+
+ Bits _stones[2]; // [0] = X, [1] = O
+ std::array<int, W> _heights;
+ int _stoneCount =0;
+ Player _lineWinner = Player::None;
+ Bits _winningLine;
+ int _lineEnds[2] = {-1, -1}; // bits at both ends of the winning run
+ mutable Bits _threats[2];
+ mutable bool _threatsValid = false;
 };
+
+using ConnectFour = ConnectN<7, 6, 4>;
+
+// Board sizes offered by the Connect 4 view; the index is stored in the "c4Board" app property.
+enum class ConnectVariant : int
+{
+ Classic = 0, // 7x6, four in a row
+ Board8x7 = 1,
+ Board9x7 = 2,
+ Board10x8 = 3,
+ Connect5 = 4, // 9x6, five in a row
+};
+
+inline ConnectVariant clampConnectVariant(int idx)
+{
+ if (idx < static_cast<int>(ConnectVariant::Classic)) return ConnectVariant::Classic;
+ if (idx > static_cast<int>(ConnectVariant::Connect5)) return ConnectVariant::Connect5;
+ return static_cast<ConnectVariant>(idx);
+}
+
+inline std::unique_ptr<ConnectBoard> makeConnectBoard(ConnectVariant variant)
+{
+ switch (variant)
+ {
+ case ConnectVariant::Board8x7: return std::make_unique<ConnectN<8, 7, 4>>();
+ case ConnectVariant::Board9x7: return std::make_unique<ConnectN<9, 7, 4>>();
+ case ConnectVariant::Board10x8: return std::make_unique<ConnectN<10, 8, 4>>();
+ case ConnectVariant::Connect5: return std::make_unique<ConnectN<9, 6, 5>>();
+ default: return std::make_unique<ConnectFour>();
+ }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <gui/Application.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include "AIPlayer.h"
+
+// A view's hint search: runs on its own engine and thread and hands the result to the UI thread.
+// Only one search runs at a time; start() and stop() cancel the one in flight, and a result
+// posted before that is dropped by generation. Call start() and stop() on the UI thread only.
+class HintSearch
+{
+public:
+    HintSearch() = default;
+    HintSearch(const HintSearch&) = delete;
+    HintSearch& operator=(const HintSearch&) = delete;
+
+    ~HintSearch()
+    {
+        stop();
+    }
+
+    // Searches position with config (its cancel flag is replaced by this object's) and calls
+    // onResult with the result on the UI thread, unless the search is stopped first.
+    void start(std::shared_ptr<const Game> position, EngineConfig config, std::function<void(const SearchResult&)> onResult)
+    {
+        stop();
+        config.cancel = &_stop;
+        _stop = false;
+        _pending = true;
+        const int gen = ++_gen;
+        _thread = std::thread([this, position, config, onResult, gen]() {
+            const SearchResult result = _player.chooseMoveDetailed(*position, config);
+            auto* fn = new gui::AsyncFn([this, result, onResult, gen]() {
+                if (gen != _gen)
+                    return;
+                _pending = false;
+                onResult(result);
+                });
+            gui::NatObject::asyncCall(fn, true);
+            });
+    }
+
+    // Cancels and joins the running search, if any
+    void stop()
+    {
+        _stop = true;
+        if (_thread.joinable())
+            _thread.join();
+        ++_gen;
+        _pending = false;
+    }
+
+    // A search was started and its result has not been delivered yet
+    bool isPending() const { return _pending; }
+
+    AIPlayer& player() { return _player; }
+
+private:
+    AIPlayer _player; // separate engine so a hint never shares state with the AI's search
+    std::thread _thread;
+    std::atomic<bool> _stop{ true };
+    int _gen = 0;
+    bool _pending = false;
+};
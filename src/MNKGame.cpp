@@ -0,0 +1,592 @@
+#include "MNKGame.h"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <random>
+
+namespace
+{
+	const std::uint64_t kKeyTag = std::uint64_t(3) << 62;
+
+	// Rank of a move that wins at once, and of one that blocks an opponent's win
+	const int kWinRank = 1 << 24;
+	const int kBlockRank = 1 << 22;
+
+	const int kMaxEval = 900; // stays below the search's win scores (1000+)
+
+	int sideOf(Player player)
+	{
+		return player == Player::X ? 0 : 1;
+	}
+
+	// Score of a window holding stones of one player only: x4 per stone
+	int windowWeight(int stones)
+	{
+		return stones > 0 ? 1 << std::min(2 * (stones - 1), 16) : 0;
+	}
+}
+
+// Board geometry and keys, built once per size and shared by every game of that size
+struct MNKGame::Layout
+{
+	int width;
+	int height;
+	int run;
+	int cells;
+	int symmetries;
+	std::vector<int> windowCells;     // run cells per window
+	std::vector<int> cellWindowStart; // windows through cell c: cellWindows[start[c] .. start[c + 1])
+	std::vector<int> cellWindows;
+	std::vector<int> forward;         // [s * cells + c] = index of cell c in symmetry s
+	std::vector<int> inverse;         // [s * cells + t] = cell mapped onto t by symmetry s
+	std::vector<std::uint64_t> zobrist; // [side * cells + c]
+	std::uint64_t sideKey;
+
+	int windowCount() const { return static_cast<int>(windowCells.size()) / run; }
+
+	Layout(int w, int h, int k)
+		: width(w), height(h), run(k), cells(w * h), symmetries(w == h ? 8 : 4)
+	{
+		const int dirs[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } }; // (row, column) steps
+		std::vector<std::vector<int>> through(cells);
+		for (const auto& d : dirs)
+		{
+			for (int r = 0; r < height; ++r)
+			{
+				for (int c = 0; c < width; ++c)
+				{
+					const int endR = r + d[0] * (run - 1);
+					const int endC = c + d[1] * (run - 1);
+					if (endR < 0 || endR >= height || endC < 0 || endC >= width)
+						continue;
+					const int window = windowCount();
+					for (int i = 0; i < run; ++i)
+					{
+						const int cell = (r + d[0] * i) * width + c + d[1] * i;
+						windowCells.push_back(cell);
+						through[cell].push_back(window);
+					}
+				}
+			}
+		}
+		cellWindowStart.push_back(0);
+		for (const auto& list : through)
+		{
+			cellWindows.insert(cellWindows.end(), list.begin(), list.end());
+			cellWindowStart.push_back(static_cast<int>(cellWindows.size()));
+		}
+
+		// Identity, rotation by 180 and the two mirrors; square boards add 90/270 and both diagonals
+		forward.resize(symmetries * cells);
+		inverse.resize(symmetries * cells);
+		for (int s = 0; s < symmetries; ++s)
+		{
+			for (int r = 0; r < height; ++r)
+			{
+				for (int c = 0; c < width; ++c)
+				{
+					const int rr = height - 1 - r;
+					const int rc = width - 1 - c;
+					int tr = r, tc = c;
+					switch (s)
+					{
+					case 1: tr = rr; tc = rc; break; // rotate 180
+					case 2: tc = rc; break;          // mirror left/right
+					case 3: tr = rr; break;          // mirror top/bottom
+					case 4: tr = c; tc = rr; break;  // rotate 90
+					case 5: tr = rc; tc = r; break;  // rotate 270
+					case 6: tr = c; tc = r; break;   // main diagonal
+					case 7: tr = rc; tc = rr; break; // anti-diagonal
+					default: break;
+					}
+					forward[s * cells + r * width + c] = tr * width + tc;
+					inverse[s * cells + tr * width + tc] = r * width + c;
+				}
+			}
+		}
+
+		// Fixed seed: keys are the same on every run, so saved tables stay valid
+		std::mt19937_64 rng(0x6D6E6B5A6F627269ULL ^ (std::uint64_t(width) << 16) ^ (std::uint64_t(height) << 8) ^ std::uint64_t(run));
+		zobrist.resize(2 * cells);
+		for (auto& key : zobrist)
+			key = rng();
+		sideKey = rng();
+	}
+};
+
+std::shared_ptr<const MNKGame::Layout> MNKGame::layoutFor(int width, int height, int runLength)
+{
+	static std::mutex mutex;
+	static std::vector<std::shared_ptr<const Layout>> layouts;
+	std::lock_guard<std::mutex> lock(mutex);
+	for (const auto& layout : layouts)
+	{
+		if (layout->width == width && layout->height == height && layout->run == runLength)
+			return layout;
+	}
+	layouts.push_back(std::make_shared<const Layout>(width, height, runLength));
+	return layouts.back();
+}
+
+MNKGame::MNKGame(int width, int height, int runLength)
+	: _layout(nullptr)
+	, _width(std::clamp(width, 3, kMaxSide))
+	, _height(std::clamp(height, 3, kMaxSide))
+	, _run(std::clamp(runLength, 3, std::max(_width, _height)))
+{
+	_layout = layoutFor(_width, _height, _run);
+	clearBoard();
+}
+
+std::unique_ptr<Game> MNKGame::clone() const
+{
+	return std::make_unique<MNKGame>(*this);
+}
+
+bool MNKGame::placeMove(Player player, Move move)
+{
+	if (move < 0 || move >= _layout->cells || _cells[move] != 0 || player == Player::None)
+		return false;
+
+	const Layout& layout = *_layout;
+	const int me = sideOf(player);
+	const int them = 1 - me;
+	_cells[move] = static_cast<std::uint8_t>(me + 1);
+	++_stones;
+
+	// A window gains for its owner, or dies for the opponent when this is the first stone against it
+	for (int i = layout.cellWindowStart[move]; i < layout.cellWindowStart[move + 1]; ++i)
+	{
+		const int window = layout.cellWindows[i];
+		const int own = _windowCount[me][window];
+		const int other = _windowCount[them][window];
+		if (other == 0)
+			_score[me] += windowWeight(own + 1) - windowWeight(own);
+		else if (own == 0)
+			_score[them] -= windowWeight(other);
+		_windowCount[me][window] = static_cast<std::uint8_t>(own + 1);
+		if (own + 1 == _run && _lineWinner == Player::None)
+		{
+			_lineWinner = player;
+			_winningWindow = window;
+		}
+	}
+
+	const int row = move / _width;
+	const int col = move % _width;
+	for (int r = std::max(0, row - 2); r <= std::min(_height - 1, row + 2); ++r)
+	{
+		for (int c = std::max(0, col - 2); c <= std::min(_width - 1, col + 2); ++c)
+			++_near[r * _width + c];
+	}
+
+	for (int s = 0; s < layout.symmetries; ++s)
+		_keys[s] ^= layout.zobrist[me * layout.cells + layout.forward[s * layout.cells + move]];
+	return true;
+}
+
+void MNKGame::clearBoard()
+{
+	const Layout& layout = *_layout;
+	_cells.assign(layout.cells, 0);
+	_near.assign(layout.cells, 0);
+	_windowCount[0].assign(layout.windowCount(), 0);
+	_windowCount[1].assign(layout.windowCount(), 0);
+	_score[0] = _score[1] = 0;
+	std::fill(std::begin(_keys), std::end(_keys), 0);
+	_stones = 0;
+	_lineWinner = Player::None;
+	_winningWindow = -1;
+}
+
+bool MNKGame::isDraw() const
+{
+	return _lineWinner == Player::None && _stones == _layout->cells;
+}
+
+int MNKGame::moveRank(Player player, int cell) const
+{
+	const Layout& layout = *_layout;
+	const int me = sideOf(player);
+	int rank = 0;
+	for (int i = layout.cellWindowStart[cell]; i < layout.cellWindowStart[cell + 1]; ++i)
+	{
+		const int window = layout.cellWindows[i];
+		const int own = _windowCount[me][window];
+		const int other = _windowCount[1 - me][window];
+		if (other == 0)
+			rank += (own + 1 == _run) ? kWinRank : windowWeight(own + 1);
+		else if (own == 0)
+			rank += (other + 1 == _run) ? kBlockRank : windowWeight(other + 1);
+	}
+	return rank;
+}
+
+std::vector<Game::Move> MNKGame::getValidMoves() const
+{
+	std::vector<Move> moves;
+	if (_gameOver)
+		return moves;
+	if (_stones == 0)
+	{
+		moves.push_back((_height / 2) * _width + _width / 2);
+		return moves;
+	}
+
+	std::vector<std::pair<int, Move>> ranked;
+	ranked.reserve(64);
+	for (int cell = 0; cell < _layout->cells; ++cell)
+	{
+		if (_cells[cell] == 0 && _near[cell] != 0)
+			ranked.emplace_back(-moveRank(_currentPlayer, cell), cell);
+	}
+	const size_t count = std::min<size_t>(ranked.size(), kMaxCandidates);
+	std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end());
+	moves.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+		moves.push_back(ranked[i].second);
+	return moves;
+}
+
+bool MNKGame::isWinningMove(Player player, Move move) const
+{
+	if (move < 0 || move >= _layout->cells || _cells[move] != 0 || player == Player::None)
+		return false;
+
+	const Layout& layout = *_layout;
+	const int me = sideOf(player);
+	for (int i = layout.cellWindowStart[move]; i < layout.cellWindowStart[move + 1]; ++i)
+	{
+		const int window = layout.cellWindows[i];
+		if (_windowCount[me][window] == _run - 1 && _windowCount[1 - me][window] == 0)
+			return true;
+	}
+	return false;
+}
+
+int MNKGame::winningCells(Player player, int* cells, int maxCells) const
+{
+	const Layout& layout = *_layout;
+	const int me = sideOf(player);
+	const int windows = layout.windowCount();
+	int count = 0;
+	for (int window = 0; window < windows && count < maxCells; ++window)
+	{
+		if (_windowCount[me][window] != _run - 1 || _windowCount[1 - me][window] != 0)
+			continue;
+		const int* cell = &layout.windowCells[window * _run];
+		int empty = 0;
+		while (_cells[cell[empty]] != 0)
+			++empty;
+		if (std::find(cells, cells + count, cell[empty]) == cells + count)
+			cells[count++] = cell[empty];
+	}
+	return count;
+}
+
+int MNKGame::evaluate(Player player) const
+{
+	const int me = sideOf(player);
+	return std::clamp(_score[me] - _score[1 - me], -kMaxEval, kMaxEval);
+}
+
+std::uint64_t MNKGame::keyUnder(int symmetry) const
+{
+	std::uint64_t key = _keys[symmetry];
+	if (_currentPlayer == Player::O)
+		key ^= _layout->sideKey;
+	return key | kKeyTag;
+}
+
+std::uint64_t MNKGame::getCanonicalKey(int& symmetry) const
+{
+	symmetry = 0;
+	std::uint64_t best = keyUnder(0);
+	for (int s = 1; s < _layout->symmetries; ++s)
+	{
+		const std::uint64_t key = keyUnder(s);
+		if (key < best)
+		{
+			best = key;
+			symmetry = s;
+		}
+	}
+	return best;
+}
+
+Game::Move MNKGame::toCanonicalMove(Move move, int symmetry) const
+{
+	if (move < 0 || move >= _layout->cells || symmetry < 0 || symmetry >= _layout->symmetries)
+		return move;
+	return _layout->forward[symmetry * _layout->cells + move];
+}
+
+Game::Move MNKGame::fromCanonicalMove(Move move, int symmetry) const
+{
+	if (move < 0 || move >= _layout->cells || symmetry < 0 || symmetry >= _layout->symmetries)
+		return move;
+	return _layout->inverse[symmetry * _layout->cells + move];
+}
+
+Player MNKGame::randomPlayout(std::mt19937& rng) const
+{
+	if (_gameOver)
+		return _winner;
+
+	MNKGame game(*this);
+	std::vector<Move> candidates;
+	candidates.reserve(_layout->cells);
+	while (!game._gameOver)
+	{
+		candidates.clear();
+		for (int cell = 0; cell < _layout->cells; ++cell)
+		{
+			if (game._cells[cell] == 0 && (game._near[cell] != 0 || game._stones == 0))
+				candidates.push_back(cell);
+		}
+		if (candidates.empty())
+			return Player::None;
+		game.makeMove(candidates[rng() % candidates.size()]);
+	}
+	return game._winner;
+}
+
+Player MNKGame::getCell(int row, int col) const
+{
+	if (row < 0 || row >= _height || col < 0 || col >= _width)
+		return Player::None;
+	const int cell = _cells[row * _width + col];
+	return cell == 1 ? Player::X : cell == 2 ? Player::O : Player::None;
+}
+
+std::vector<int> MNKGame::getWinningLine() const
+{
+	if (_winningWindow < 0)
+		return {};
+	const auto first = _layout->windowCells.begin() + _winningWindow * _run;
+	return std::vector<int>(first, first + _run);
+}
+
+// Threat-space search
+
+struct MNKGame::ThreatContext
+{
+	std::uint64_t nodes = 0;
+	std::uint64_t nodeLimit = 0;
+	bool hasDeadline = false;
+	std::chrono::steady_clock::time_point deadline;
+	const std::atomic<bool>* stop = nullptr;
+	const std::atomic<bool>* cancel = nullptr;
+	bool aborted = false;
+
+	bool exhausted()
+	{
+		if (!aborted)
+		{
+			aborted = (nodeLimit && nodes >= nodeLimit)
+				|| (stop && stop->load(std::memory_order_relaxed))
+				|| (cancel && cancel->load(std::memory_order_relaxed))
+				|| (hasDeadline && (nodes & 255) == 0 && std::chrono::steady_clock::now() >= deadline);
+		}
+		return aborted;
+	}
+};
+
+bool MNKGame::threeDefences(Player attacker, int three, std::vector<int>& defences) const
+{
+	// A double four played at f can only be stopped by taking f or one of the cells it threatens.
+	// Any f will do to bound the replies; intersecting all of them through the three keeps the
+	// fewest. f is looked for in the windows through the three, where the new threats come from.
+	const Layout& layout = *_layout;
+	const int me = sideOf(attacker);
+	std::vector<int> tried;
+	bool found = false;
+	for (int i = layout.cellWindowStart[three]; i < layout.cellWindowStart[three + 1]; ++i)
+	{
+		const int window = layout.cellWindows[i];
+		if (_windowCount[me][window] != _run - 2 || _windowCount[1 - me][window] != 0)
+			continue;
+		for (int j = 0; j < _run; ++j)
+		{
+			const int f = layout.windowCells[window * _run + j];
+			if (_cells[f] != 0 || std::find(tried.begin(), tried.end(), f) != tried.end())
+				continue;
+			tried.push_back(f);
+
+			// Cells f would threaten: the other empty cell of each window it brings to run - 1
+			std::vector<int> stoppers(1, f);
+			for (int k = layout.cellWindowStart[f]; k < layout.cellWindowStart[f + 1]; ++k)
+			{
+				const int w = layout.cellWindows[k];
+				if (_windowCount[me][w] != _run - 2 || _windowCount[1 - me][w] != 0)
+					continue;
+				for (int m = 0; m < _run; ++m)
+				{
+					const int cell = layout.windowCells[w * _run + m];
+					if (cell != f && _cells[cell] == 0 && std::find(stoppers.begin(), stoppers.end(), cell) == stoppers.end())
+						stoppers.push_back(cell);
+				}
+			}
+			if (stoppers.size() < 3)
+				continue; // a single four, not a double
+
+			if (!found)
+			{
+				defences = stoppers;
+				found = true;
+			}
+			else
+			{
+				defences.erase(std::remove_if(defences.begin(), defences.end(), [&](int cell) {
+					return std::find(stoppers.begin(), stoppers.end(), cell) == stoppers.end();
+					}), defences.end());
+			}
+		}
+	}
+	return found;
+}
+
+bool MNKGame::threatWins(ThreatContext& ctx, int threatsLeft, Move* winningMove) const
+{
+	++ctx.nodes;
+	if (ctx.exhausted())
+		return false;
+
+	const Layout& layout = *_layout;
+	const Player attacker = _currentPlayer;
+	const Player defender = (attacker == Player::X) ? Player::O : Player::X;
+	const int me = sideOf(attacker);
+	const int them = 1 - me;
+
+	int cells[3];
+	if (winningCells(attacker, cells, 1) > 0)
+	{
+		if (winningMove)
+			*winningMove = cells[0];
+		return true;
+	}
+	const int defenderWins = winningCells(defender, cells, 2);
+	if (defenderWins >= 2 || threatsLeft <= 0)
+		return false;
+
+	// Fours (a window reaches run - 1) first, then threes (run - 2, which need a move to follow)
+	std::vector<int> fours;
+	std::vector<int> threes;
+	for (int cell = 0; cell < layout.cells; ++cell)
+	{
+		if (_cells[cell] != 0 || _near[cell] == 0 || (defenderWins == 1 && cell != cells[0]))
+			continue;
+		bool four = false;
+		bool three = false;
+		for (int i = layout.cellWindowStart[cell]; i < layout.cellWindowStart[cell + 1] && !four; ++i)
+		{
+			const int window = layout.cellWindows[i];
+			if (_windowCount[them][window] != 0)
+				continue;
+			four = _windowCount[me][window] == _run - 2;
+			three = three || (_windowCount[me][window] == _run - 3 && _run > 3);
+		}
+		if (four)
+			fours.push_back(cell);
+		else if (three && threatsLeft >= 2)
+			threes.push_back(cell);
+	}
+
+	auto tryMove = [&](int move, bool isThree) {
+		MNKGame next(*this);
+		next.makeMove(move);
+		int threats[3];
+		const int count = next.winningCells(attacker, threats, 2);
+		if (count >= 2)
+			return true; // the defender has no win of its own and can block only one
+
+		std::vector<int> replies;
+		if (count == 1)
+		{
+			replies.push_back(threats[0]);
+		}
+		else if (!isThree || !next.threeDefences(attacker, move, replies))
+		{
+			return false;
+		}
+		else
+		{
+			// The defender may also answer with a four of its own, which the attacker must block
+			for (int window = 0; window < layout.windowCount(); ++window)
+			{
+				if (next._windowCount[them][window] != _run - 2 || next._windowCount[me][window] != 0)
+					continue;
+				for (int j = 0; j < _run; ++j)
+				{
+					const int cell = layout.windowCells[window * _run + j];
+					if (next._cells[cell] == 0 && std::find(replies.begin(), replies.end(), cell) == replies.end())
+						replies.push_back(cell);
+				}
+			}
+		}
+
+		for (int reply : replies)
+		{
+			MNKGame answered(next);
+			answered.makeMove(reply);
+			if (answered._gameOver || !answered.threatWins(ctx, threatsLeft - 1, nullptr))
+				return false;
+		}
+		return true;
+	};
+
+	for (int move : fours)
+	{
+		if (tryMove(move, false))
+		{
+			if (winningMove)
+				*winningMove = move;
+			return true;
+		}
+		if (ctx.aborted)
+			return false;
+	}
+	for (int move : threes)
+	{
+		if (tryMove(move, true))
+		{
+			if (winningMove)
+				*winningMove = move;
+			return true;
+		}
+		if (ctx.aborted)
+			return false;
+	}
+	return false;
+}
+
+MNKGame::ThreatResult MNKGame::findThreatWin(int maxThreats, std::uint64_t nodeLimit, int timeBudgetMs,
+	const std::atomic<bool>* stop, const std::atomic<bool>* cancel) const
+{
+	ThreatResult result;
+	if (_gameOver || _stones == 0)
+		return result;
+
+	ThreatContext ctx;
+	ctx.nodeLimit = nodeLimit;
+	ctx.stop = stop;
+	ctx.cancel = cancel;
+	if (timeBudgetMs > 0)
+	{
+		ctx.hasDeadline = true;
+		ctx.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeBudgetMs);
+	}
+
+	// Deepen one threat at a time, so the shortest forced win is found first
+	for (int threats = 1; threats <= maxThreats && !ctx.aborted; ++threats)
+	{
+		Move move = -1;
+		if (threatWins(ctx, threats, &move))
+		{
+			result.move = move;
+			break;
+		}
+	}
+	result.nodes = ctx.nodes;
+	return result;
+}
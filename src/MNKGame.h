@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "AIPlayer.h"
+
+// m,n,k-game: players alternately place stones on a width x height board and the first to get
+// runLength in a row (horizontally, vertically or diagonally; longer rows count) wins. The default
+// is 15x15 five in a row (free-style Gomoku).
+//
+// Everything the engine asks for is kept up to date in placeMove instead of being rescanned:
+// the stone count of every winning window (runLength cells in a row), the line-pattern score of
+// each player, the number of stones near every cell (which cells are move candidates) and one
+// Zobrist key per board symmetry. Moves are cell indices, row * width + column.
+class MNKGame : public Game
+{
+public:
+    static constexpr int kMaxSide = 19;
+    static constexpr int kDefaultSide = 15;
+    static constexpr int kDefaultRun = 5;
+    // getValidMoves returns at most this many of the best ranked candidates
+    static constexpr int kMaxCandidates = 20;
+
+    explicit MNKGame(int width = kDefaultSide, int height = kDefaultSide, int runLength = kDefaultRun);
+
+    std::unique_ptr<Game> clone() const override;
+    // Empty cells within two cells of a stone (the center on an empty board), ranked by how much
+    // they do for either player: winning and blocking moves first.
+    std::vector<Move> getValidMoves() const override;
+    Player checkWin() const override { return _lineWinner; }
+    bool isDraw() const override;
+    // Zobrist key with bits 62 and 63 set, which keeps these keys apart from the other games' in a
+    // shared table.
+    std::uint64_t getKey() const override { return keyUnder(0); }
+    // Smallest key over the board symmetries: 8 on square boards, 4 otherwise.
+    std::uint64_t getCanonicalKey(int& symmetry) const override;
+    Move toCanonicalMove(Move move, int symmetry) const override;
+    Move fromCanonicalMove(Move move, int symmetry) const override;
+    // Random stones near the existing ones (candidate cells only) to the end of the game.
+    Player randomPlayout(std::mt19937& rng) const override;
+    bool isWinningMove(Player player, Move move) const override;
+
+    // Line-pattern score from player's point of view: every window still open for one side counts
+    // for it, more the fuller it is. Clamped below the search's win scores.
+    int evaluate(Player player) const;
+
+    // Threat-space search for the side to move: looks for a win forced by a sequence of fours (one
+    // winning cell, a single reply) and threes (a double four next, replies limited to the cells
+    // that stop it and the defender's own fours). maxThreats bounds the attacker's moves in a line;
+    // nodeLimit and timeBudgetMs (0 = unlimited) and either flag end the attempt early.
+    struct ThreatResult
+    {
+        Move move{ -1 }; // first move of a forced win, -1 if none was found
+        std::uint64_t nodes{ 0 };
+    };
+    ThreatResult findThreatWin(int maxThreats, std::uint64_t nodeLimit, int timeBudgetMs,
+        const std::atomic<bool>* stop = nullptr, const std::atomic<bool>* cancel = nullptr) const;
+
+    int width() const { return _width; }
+    int height() const { return _height; }
+    int runLength() const { return _run; }
+    int stoneCount() const { return _stones; }
+    Player getCell(int row, int col) const;
+    // Cells of the completed line after a win (runLength cells), empty otherwise.
+    std::vector<int> getWinningLine() const;
+
+protected:
+    bool placeMove(Player player, Move move) override;
+    void clearBoard() override;
+
+private:
+    struct Layout;
+    struct ThreatContext;
+
+    static std::shared_ptr<const Layout> layoutFor(int width, int height, int runLength);
+    std::uint64_t keyUnder(int symmetry) const;
+    // Distinct empty cells that would complete a line for player, up to maxCells of them
+    int winningCells(Player player, int* cells, int maxCells) const;
+    int moveRank(Player player, int cell) const;
+    bool threatWins(ThreatContext& ctx, int threatsLeft, Move* winningMove) const;
+    // Cells the defender must take to stop every double four the attacker could play next
+    bool threeDefences(Player attacker, int three, std::vector<int>& defences) const;
+
+    std::shared_ptr<const Layout> _layout; // shared by every game of this size
+    int _width;
+    int _height;
+    int _run;
+    int _stones{ 0 };
+    std::vector<std::uint8_t> _cells;      // 0 = empty, 1 = X, 2 = O
+    std::vector<std::uint8_t> _near;       // stones within two cells
+    std::vector<std::uint8_t> _windowCount[2]; // stones of X / O in every window
+    int _score[2]{ 0, 0 };
+    std::uint64_t _keys[8]{};
+    Player _lineWinner{ Player::None };
+    int _winningWindow{ -1 };
+};
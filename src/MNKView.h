@@ -0,0 +1,670 @@
+#pragma once
+#include <gui/Canvas.h>
+#include <gui/Shape.h>
+#include <gui/Sound.h>
+#include <gui/DrawableString.h>
+#include <gui/Application.h>
+#include <td/Types.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <cnt/StringBuilder.h>
+#include <string>
+#include "MNKGame.h"
+#include "AIPlayer.h"
+#include "HintSearch.h"
+#include "Theme.h"
+#include "ScoreManager.h"
+
+
+extern "C" int getThemeIndex();
+
+#ifndef CONNECTXO_UI_FONT
+#if defined(__APPLE__)
+#define CONNECTXO_UI_FONT "Helvetica Neue"
+#else
+#define CONNECTXO_UI_FONT "Segoe UI"
+#endif
+#endif
+
+// Five in a row on a 15x15 board (an m,n,k-game). Stones go on the intersections of the grid;
+// the layout (title, board with Quit/Hint/Replay on the right, counters at the bottom) follows
+// TicTacToeView.
+class MNKView : public gui::Canvas
+{
+public:
+    MNKView()
+        : Canvas({ gui::InputDevice::Event::PrimaryClicks, gui::InputDevice::Event::CursorMove })
+        , _game()
+        , _clickSound(":click")
+    {
+        enableResizeEvent(true);
+        _game.reset(Player::X);
+
+        // Load persisted scores from ScoreManager
+        _winCounter = ScoreManager::getInstance().getMNKStats().wins;
+        _lossCounter = ScoreManager::getInstance().getMNKStats().losses;
+    }
+
+    ~MNKView()
+    {
+        _hint.stop();
+    }
+
+    // Allow parent to handle closing/removing this view
+    void onQuit(const std::function<void()>& fn) { _onQuit = fn; }
+    void onReplay(const std::function<void()>& fn) { _onReplay = fn; }
+
+protected:
+    void onResize(const gui::Size& newSize) override
+    {
+        reDraw();
+    }
+
+    void onCursorMoved(const gui::InputDevice& inputDevice) override
+    {
+        if (_cellSize <= 0) return;
+
+        const gui::Point& pt = inputDevice.getModelPoint();
+        auto pointInRect = [](const gui::Rect& r, const gui::Point& p) {
+            return (p.x >= r.left) && (p.x <= r.right) && (p.y >= r.top) && (p.y <= r.bottom);
+            };
+
+        bool wasQuitHovered = _quitBtnHovered;
+        bool wasReplayHovered = _replayBtnHovered;
+        bool wasHintHovered = _hintBtnHovered;
+        _quitBtnHovered = pointInRect(_quitBtn, pt);
+        _replayBtnHovered = pointInRect(_replayBtn, pt);
+        _hintBtnHovered = isHintEnabled() && pointInRect(_hintBtn, pt);
+        bool changed = _quitBtnHovered != wasQuitHovered || _replayBtnHovered != wasReplayHovered || _hintBtnHovered != wasHintHovered;
+
+        int row = -1;
+        int col = -1;
+        if (!_game.isGameOver() && _game.getCurrentPlayer() == _humanPlayer && !_aiMoveScheduled)
+            cellAt(pt, row, col);
+        if (row != _hoverRow || col != _hoverCol)
+        {
+            _hoverRow = row;
+            _hoverCol = col;
+            changed = true;
+        }
+
+        if (changed)
+            reDraw();
+    }
+
+    void onDraw(const gui::Rect& rect) override
+    {
+        // pick theme
+        ThemeIndex themeIdx = clampThemeIndex(getThemeIndex());
+
+        td::ColorID bgColor = td::ColorID::White; // THIS COLOR CHANGES WITH THEMES
+        td::ColorID accentColor = td::ColorID::Blue; // THIS COLOR CHANGES WITH THEMES
+        td::ColorID secondaryColor = td::ColorID::Black; // THIS COLOR CHANGES WITH THEMES
+        td::ColorID gridColor = td::ColorID::Black; // THIS COLOR CHANGES WITH THEMES
+        td::ColorID boardColor = td::ColorID::BurlyWood; // THIS COLOR CHANGES WITH THEMES
+        td::ColorID winLine = td::ColorID::LimeGreen; // THIS COLOR CHANGES WITH THEMES
+        td::ColorID loseLine = td::ColorID::Red; // THIS COLOR CHANGES WITH THEMES
+
+        switch (themeIdx)
+        {
+        case ThemeIndex::Nature:
+            bgColor = td::ColorID::Snow;
+            accentColor = td::ColorID::ForestGreen;
+            secondaryColor = td::ColorID::Rust;
+            gridColor = td::ColorID::Black;
+            boardColor = td::ColorID::BurlyWood;
+            winLine = td::ColorID::Lime;
+            loseLine = td::ColorID::Red;
+            break;
+        case ThemeIndex::Strawberry:
+            bgColor = td::ColorID::FloralWhite;
+            accentColor = td::ColorID::Crimson;
+            secondaryColor = td::ColorID::MediumSpringGreen;
+            gridColor = td::ColorID::Salmon;
+            boardColor = td::ColorID::SeaShell;
+            winLine = td::ColorID::ForestGreen;
+            loseLine = td::ColorID::Red;
+            break;
+        case ThemeIndex::Beachy:
+            bgColor = td::ColorID::SeaShell;
+            accentColor = td::ColorID::CadetBlue;
+            secondaryColor = td::ColorID::DarkKhaki;
+            gridColor = td::ColorID::Gray;
+            boardColor = td::ColorID::Linen;
+            winLine = td::ColorID::Navy;
+            loseLine = td::ColorID::DarkSalmon;
+            break;
+        case ThemeIndex::Dark:
+            bgColor = td::ColorID::Black;
+            accentColor = td::ColorID::DarkOrange;
+            secondaryColor = td::ColorID::SteelBlue;
+            gridColor = td::ColorID::SlateGray;
+            boardColor = td::ColorID::ObsidianGray;
+            winLine = td::ColorID::LimeGreen;
+            loseLine = td::ColorID::Red;
+            break;
+        case ThemeIndex::Classic:
+        default:
+            bgColor = td::ColorID::White;
+            accentColor = td::ColorID::Blue;
+            secondaryColor = td::ColorID::Black;
+            gridColor = td::ColorID::Black;
+            boardColor = td::ColorID::BurlyWood;
+            winLine = td::ColorID::LimeGreen;
+            loseLine = td::ColorID::Red;
+            break;
+        }
+        td::ColorID quitBtnColor = accentColor; // THIS COLOR CHANGES WITH THEMES
+        td::ColorID replayBtnColor = secondaryColor; // THIS COLOR CHANGES WITH THEMES
+        td::ColorID textLblColor = accentColor; // THIS COLOR CHANGES WITH THEMES
+        td::ColorID drawLine = secondaryColor;
+        // X plays the accent color, O the secondary one
+        const td::ColorID stoneX = accentColor;
+        const td::ColorID stoneO = secondaryColor;
+
+        gui::Shape::drawRect(rect, bgColor);
+
+        // rows: title 2/10, play area 7/10, counters 1/10; the play area's right third holds the buttons
+        const double totalH = rect.height();
+        const double row0H = totalH * 0.20;
+        const double row1H = totalH * 0.70;
+        const double row2H = totalH * 0.10;
+        const double colW = rect.width() / 3.0;
+
+        const double row0Top = rect.top;
+        const double row0Bottom = row0Top + row0H;
+        const double row1Top = row0Bottom;
+        const double row1Bottom = row1Top + row1H;
+        const double row2Top = row1Bottom;
+        const double row2Bottom = rect.bottom;
+
+        // Top row: title spanning full width
+        {
+            td::String title = tr("mnkGame");
+            gui::Font titleFont;
+            titleFont.create(CONNECTXO_UI_FONT, 37.0f, gui::Font::Style::Bold, gui::Font::Unit::Point);
+            const double hPad = rect.width() * 0.02;
+            gui::Rect titleRect(rect.left + hPad, row0Top, rect.right - hPad, row0Bottom);
+            gui::DrawableString::draw(title, titleRect, &titleFont, textLblColor, td::TextAlignment::Center, td::VAlignment::Center);
+        }
+
+        gui::Rect playCell(rect.left, row1Top, rect.left + colW * 2.0, row1Bottom);
+        gui::Rect rightCol(rect.left + colW * 2.0, row1Top, rect.right, row1Bottom);
+
+        // One cell per intersection; the grid lines run through the cell centers
+        const int rows = _game.height();
+        const int cols = _game.width();
+        const double boardScale = 0.96;
+        const double cell = std::min(playCell.width() * boardScale / cols, playCell.height() * boardScale / rows);
+        const double boardW = cell * cols;
+        const double boardH = cell * rows;
+        _boardLeft = playCell.left + (playCell.width() - boardW) * 0.5;
+        _boardTop = playCell.top + (playCell.height() - boardH) * 0.5;
+        _cellSize = cell;
+
+        gui::Rect boardRect(_boardLeft, _boardTop, _boardLeft + boardW, _boardTop + boardH);
+        {
+            gui::Shape shBoard;
+            shBoard.createRoundedRect(boardRect, static_cast<td::Coord>(cell * 0.3), 1.0f);
+            shBoard.drawFill(boardColor);
+        }
+
+        const float gridStroke = std::max(1.0f, static_cast<float>(cell * 0.04));
+        for (int r = 0; r < rows; ++r)
+        {
+            const double y = _boardTop + (r + 0.5) * cell;
+            gui::Shape::drawLine(gui::Point(_boardLeft + cell * 0.5, y), gui::Point(_boardLeft + boardW - cell * 0.5, y), gridColor, gridStroke);
+        }
+        for (int c = 0; c < cols; ++c)
+        {
+            const double x = _boardLeft + (c + 0.5) * cell;
+            gui::Shape::drawLine(gui::Point(x, _boardTop + cell * 0.5), gui::Point(x, _boardTop + boardH - cell * 0.5), gridColor, gridStroke);
+        }
+
+        auto drawStone = [&](int row, int col, td::ColorID color, double scale) {
+            const double cx = _boardLeft + (col + 0.5) * cell;
+            const double cy = _boardTop + (row + 0.5) * cell;
+            const double radius = cell * 0.42 * scale;
+            gui::Shape sh;
+            sh.createOval(gui::Rect(cx - radius, cy - radius, cx + radius, cy + radius), 1.0f);
+            sh.drawFillAndWire(color, gridColor, 1.0f);
+        };
+
+        // Stones; the winning line (recorded by the game when it was completed) pulses
+        const std::vector<int> winningLine = _game.getWinningLine();
+        float pulseScale = 1.0f;
+        if (!winningLine.empty())
+        {
+            auto now = std::chrono::steady_clock::now();
+            float elapsedWin = std::chrono::duration<float>(now - _winPulseStartTime).count();
+            pulseScale = 1.0f + 0.08f * std::sin(elapsedWin * 8.0f);
+        }
+        for (int r = 0; r < rows; ++r)
+        {
+            for (int c = 0; c < cols; ++c)
+            {
+                const Player p = _game.getCell(r, c);
+                if (p == Player::None)
+                    continue;
+                const bool onLine = std::find(winningLine.begin(), winningLine.end(), r * cols + c) != winningLine.end();
+                drawStone(r, c, p == Player::X ? stoneX : stoneO, onLine ? pulseScale : 1.0);
+            }
+        }
+
+        // Mark the last stone so the opponent's reply is easy to find on the big board
+        if (_lastMove >= 0 && _game.getCell(_lastMove / cols, _lastMove % cols) != Player::None)
+        {
+            const double cx = _boardLeft + (_lastMove % cols + 0.5) * cell;
+            const double cy = _boardTop + (_lastMove / cols + 0.5) * cell;
+            const double radius = cell * 0.12;
+            gui::Shape sh;
+            sh.createOval(gui::Rect(cx - radius, cy - radius, cx + radius, cy + radius), 1.0f);
+            sh.drawFill(bgColor);
+        }
+
+        // Hover preview: a smaller stone of the human's color
+        if (_hoverRow >= 0 && _hoverCol >= 0 && !_game.isGameOver() &&
+            _game.getCurrentPlayer() == _humanPlayer && !_aiMoveScheduled &&
+            _game.getCell(_hoverRow, _hoverCol) == Player::None)
+        {
+            drawStone(_hoverRow, _hoverCol, _humanPlayer == Player::X ? stoneX : stoneO, 0.5);
+        }
+
+        if (!isHintFeatureEnabled())
+        {
+            _isHintActive = false;
+            _hintCell = -1;
+        }
+
+        // Hint target highlight
+        if (_isHintActive && _hintCell >= 0)
+        {
+            auto now = std::chrono::steady_clock::now();
+            float hintElapsed = std::chrono::duration<float>(now - _hintStartTime).count();
+            if (hintElapsed <= 1.2f)
+            {
+                const double cx = _boardLeft + (_hintCell % cols + 0.5) * cell;
+                const double cy = _boardTop + (_hintCell / cols + 0.5) * cell;
+                const double half = cell * 0.5;
+                gui::Shape shHintFlash;
+                shHintFlash.createRect(gui::Rect(cx - half, cy - half, cx + half, cy + half));
+                shHintFlash.drawWire(td::ColorID::Gold, std::max(2.0f, static_cast<float>(cell * 0.12)));
+            }
+            else
+            {
+                _isHintActive = false;
+            }
+        }
+
+        // Right column buttons: Quit, Hint, Replay
+        {
+            const double gap = row1H * 0.06;
+            const double vertMargin = row1H * 0.08;
+            const double availH = rightCol.height() - vertMargin * 2.0 - gap * 2.0;
+            const double rectH = availH / 3.0;
+            const double rectW = rightCol.width() * 0.8;
+            const double cx = rightCol.left + (rightCol.width() - rectW) * 0.5;
+
+            const double usedH = rectH * 3.0 + gap * 2.0;
+            const double topY = rightCol.top + (rightCol.height() - usedH) * 0.5;
+            gui::Rect topRect(cx, topY, cx + rectW, topY + rectH);
+            double hintTop = topY + rectH + gap;
+            gui::Rect hintRect(cx, hintTop, cx + rectW, hintTop + rectH);
+            double bottomTop = hintTop + rectH + gap;
+            gui::Rect bottomRect(cx, bottomTop, cx + rectW, bottomTop + rectH);
+
+            // store for click handling
+            _quitBtn = topRect;
+            _hintBtn = hintRect;
+            _replayBtn = bottomRect;
+
+            gui::Shape shTop;
+            gui::Shape shHint;
+            gui::Shape shBottom;
+            shTop.createRoundedRect(topRect, static_cast<td::Coord>(std::min(topRect.width(), topRect.height()) * 0.5), 1.0f);
+            shHint.createRoundedRect(hintRect, static_cast<td::Coord>(std::min(hintRect.width(), hintRect.height()) * 0.5), 1.0f);
+            shBottom.createRoundedRect(bottomRect, static_cast<td::Coord>(std::min(bottomRect.width(), bottomRect.height()) * 0.5), 1.0f);
+
+            const bool hintFeatureEnabled = isHintFeatureEnabled();
+            const bool hintEnabled = isHintEnabled();
+            td::ColorID hintFillColor = hintEnabled ? td::ColorID::Gold : td::ColorID::Gainsboro;
+            float quitBorder = 3.0f;
+            float replayBorder = 3.0f;
+            float hintBorder = hintEnabled ? 2.0f : 1.0f;
+
+            if (_quitBtnHovered)
+            {
+                quitBtnColor = td::ColorID::LightBlue;
+                quitBorder = 5.0f;
+            }
+            if (hintEnabled && _hintBtnHovered)
+            {
+                hintFillColor = td::ColorID::Yellow;
+                hintBorder = 3.0f;
+            }
+            if (_replayBtnHovered)
+            {
+                replayBtnColor = td::ColorID::LightGray;
+                replayBorder = 5.0f;
+            }
+
+            shTop.drawFillAndWire(quitBtnColor, bgColor, quitBorder);
+            if (hintFeatureEnabled)
+                shHint.drawFillAndWire(hintFillColor, bgColor, hintBorder);
+            shBottom.drawFillAndWire(replayBtnColor, bgColor, replayBorder);
+
+            gui::Font btnFont;
+            float btnFontSize = std::max(1.0f, static_cast<float>(rectH * 0.28));
+            btnFont.create(CONNECTXO_UI_FONT, btnFontSize, gui::Font::Style::BoldItalic, gui::Font::Unit::Point);
+            gui::DrawableString::draw(tr("quitBtn"), topRect, &btnFont, bgColor, td::TextAlignment::Center, td::VAlignment::Center);
+            if (hintFeatureEnabled)
+                gui::DrawableString::draw(tr("Hint"), hintRect, &btnFont, hintEnabled ? td::ColorID::Black : td::ColorID::DarkGray, td::TextAlignment::Center, td::VAlignment::Center);
+            gui::DrawableString::draw(tr("replayBtn"), bottomRect, &btnFont, bgColor, td::TextAlignment::Center, td::VAlignment::Center);
+        }
+
+        // Bottom row: wins (left) and losses (right)
+        if (!_game.isGameOver())
+            _countersUpdated = false;
+        recordResult();
+
+        cnt::StringBuilderSmall sbW;
+        sbW.appendString(tr("winsCounterLbl"));
+        sbW.appendCString(" ");
+        std::string tmpW = std::to_string(_winCounter);
+        sbW.appendString(tmpW.c_str());
+        td::String winsStr = sbW.toString();
+
+        cnt::StringBuilderSmall sbL;
+        sbL.appendString(tr("lossesCounterLbl"));
+        sbL.appendCString(" ");
+        std::string tmpL = std::to_string(_lossCounter);
+        sbL.appendString(tmpL.c_str());
+        td::String lossStr = sbL.toString();
+
+        const double hPad = std::max(rect.width() * 0.02, colW * 0.06);
+        float fontSizePt = std::max(1.0f, static_cast<float>(row2H * 0.25));
+        gui::Font counterFont;
+        counterFont.create(CONNECTXO_UI_FONT, fontSizePt, gui::Font::Style::Bold, gui::Font::Unit::Point);
+
+        gui::Rect bottomCol0(rect.left + hPad, row2Top, rect.left + colW - hPad, row2Bottom);
+        gui::DrawableString::draw(winsStr, bottomCol0, &counterFont, textLblColor, td::TextAlignment::Left, td::VAlignment::Center);
+
+        gui::Rect bottomCol2(rect.left + colW * 2.0 + hPad, row2Top, rect.right - hPad, row2Bottom);
+        gui::DrawableString::draw(lossStr, bottomCol2, &counterFont, textLblColor, td::TextAlignment::Right, td::VAlignment::Center);
+
+        if (_game.isGameOver())
+        {
+            td::ColorID resultColor = drawLine;
+            td::String lbl = tr("draw");
+            if (_game.getWinner() == _humanPlayer)
+            {
+                resultColor = winLine;
+                lbl = tr("youWin");
+            }
+            else if (_game.getWinner() == _AIrole)
+            {
+                resultColor = loseLine;
+                lbl = tr("youLose");
+            }
+
+            // Line through the centers of the first and last stones of the winning row
+            if (!winningLine.empty())
+            {
+                const int first = winningLine.front();
+                const int last = winningLine.back();
+                gui::Point p0(_boardLeft + (first % cols + 0.5) * cell, _boardTop + (first / cols + 0.5) * cell);
+                gui::Point p1(_boardLeft + (last % cols + 0.5) * cell, _boardTop + (last / cols + 0.5) * cell);
+                gui::Shape::drawLine(p0, p1, resultColor, std::max(3.0f, static_cast<float>(cell * 0.18)));
+            }
+
+            gui::Rect overlay(rect.left + colW, row2Top, rect.left + colW * 2.0, row2Bottom);
+            float overlayFontSize = std::max(6.0f, static_cast<float>(row2H * 0.35));
+            gui::Font overlayFont;
+            overlayFont.create(CONNECTXO_UI_FONT, overlayFontSize, gui::Font::Style::BoldItalic, gui::Font::Unit::Point);
+            gui::DrawableString::draw(lbl, overlay, &overlayFont, resultColor, td::TextAlignment::Center, td::VAlignment::Center);
+        }
+
+        if (_isHintActive)
+            reDraw();
+    }
+
+    void onPrimaryButtonReleased(const gui::InputDevice& inputDevice) override
+    {
+        if (_cellSize <= 0) return; // Not yet drawn
+
+        const gui::Point& pt = inputDevice.getModelPoint();
+        auto pointInRect = [](const gui::Rect& r, const gui::Point& p) {
+            return (p.x >= r.left) && (p.x <= r.right) && (p.y >= r.top) && (p.y <= r.bottom);
+            };
+
+        if (pointInRect(_quitBtn, pt))
+        {
+            // Quit: invalidate any pending AI move and notify parent
+            ++_aiGen;
+            _aiMoveScheduled = false;
+            _hint.stop();
+            _isHintActive = false;
+            _hintCell = -1;
+            _hoverRow = -1;
+            _hoverCol = -1;
+            if (_onQuit)
+                _onQuit();
+            else
+            {
+                gui::Window* pWnd = getParentWindow();
+                if (pWnd)
+                    pWnd->hide(true);
+            }
+            reDraw();
+            return;
+        }
+
+        if (pointInRect(_replayBtn, pt))
+        {
+            // Replay: swap sides and start over, X always moves first
+            ++_aiGen;
+            _aiMoveScheduled = false;
+            _hint.stop();
+            _hoverRow = -1;
+            _hoverCol = -1;
+            _isHintActive = false;
+            _hintCell = -1;
+            _lastMove = -1;
+            _humanPlayer = (_humanPlayer == Player::X) ? Player::O : Player::X;
+            _AIrole = (_humanPlayer == Player::X) ? Player::O : Player::X;
+            _game.reset(Player::X);
+            _countersUpdated = false;
+            _winPulseStartTime = std::chrono::steady_clock::now();
+
+            if (_humanPlayer != Player::X)
+                scheduleAIMove();
+
+            if (_onReplay)
+                _onReplay();
+            reDraw();
+            return;
+        }
+
+        if (pointInRect(_hintBtn, pt))
+        {
+            if (isHintEnabled())
+                startHint();
+            return;
+        }
+
+        // Board click: only on the human's turn
+        if (_game.isGameOver() || _aiMoveScheduled) return;
+        if (_game.getCurrentPlayer() != _humanPlayer) return;
+
+        int row, col;
+        if (!cellAt(pt, row, col) || _game.getCell(row, col) != Player::None)
+            return;
+
+        const int move = row * _game.width() + col;
+        if (!_game.makeMove(move))
+            return;
+        _lastMove = move;
+        _clickSound.play();
+        _hoverRow = -1;
+        _hoverCol = -1;
+        _hint.stop();
+        _isHintActive = false;
+
+        recordResult();
+        reDraw();
+        if (_game.isGameOver())
+            return;
+
+        scheduleAIMove();
+    }
+
+private:
+    // Intersection under the point, if any
+    bool cellAt(const gui::Point& pt, int& row, int& col) const
+    {
+        if (_cellSize <= 0)
+            return false;
+        const double x = (pt.x - _boardLeft) / _cellSize;
+        const double y = (pt.y - _boardTop) / _cellSize;
+        if (x < 0 || y < 0)
+            return false;
+        col = static_cast<int>(x);
+        row = static_cast<int>(y);
+        if (row < _game.height() && col < _game.width())
+            return true;
+        row = col = -1;
+        return false;
+    }
+
+    // Counts a finished game once
+    void recordResult()
+    {
+        if (!_game.isGameOver() || _countersUpdated)
+            return;
+        Player winner = _game.getWinner();
+        if (winner == _humanPlayer)
+        {
+            ++_winCounter;
+            ++ScoreManager::getInstance().getMNKStats().wins;
+            ScoreManager::getInstance().saveMNKStats();
+        }
+        else if (winner == _AIrole)
+        {
+            ++_lossCounter;
+            ++ScoreManager::getInstance().getMNKStats().losses;
+            ScoreManager::getInstance().saveMNKStats();
+        }
+        _countersUpdated = true;
+    }
+
+    // Searches a copy of the position on a worker thread and plays the reply on the UI thread,
+    // unless a replay or quit happened in the meantime.
+    void scheduleAIMove()
+    {
+        _aiMoveScheduled = true;
+        int gen = ++_aiGen;
+        const EngineConfig config = EngineConfig::forCurrentDifficulty(12); // snapshot on the UI thread
+        std::shared_ptr<const MNKGame> snapshot = std::make_shared<MNKGame>(_game);
+        std::thread aiThread([this, gen, config, snapshot]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            Game::Move aiMove = _aiPlayer.chooseMove(*snapshot, config);
+            auto* fn = new gui::AsyncFn([this, aiMove, gen]() {
+                if (gen != _aiGen)
+                    return;
+                if (!_game.isGameOver() && aiMove >= 0 && _game.makeMove(aiMove))
+                    _lastMove = aiMove;
+                _aiMoveScheduled = false;
+                recordResult();
+                reDraw();
+                });
+            gui::NatObject::asyncCall(fn, true);
+            });
+        aiThread.detach();
+    }
+
+    bool isHintFeatureEnabled() const
+    {
+        const gui::Application* app = getApplication();
+        if (!app)
+            return true;
+        auto props = const_cast<gui::Application*>(app)->getProperties();
+        if (!props)
+            return true;
+        return props->getValue("showHint", 1) != 0;
+    }
+
+    bool isHintEnabled() const
+    {
+        return isHintFeatureEnabled() && !_game.isGameOver() && _game.getCurrentPlayer() == _humanPlayer && !_aiMoveScheduled
+            && !_hint.isPending();
+    }
+
+    // Full-strength move for the human within the Very Hard tier's time, searched off the UI
+    // thread; the Hint button stays disabled until the result is shown.
+    void startHint()
+    {
+        EngineConfig config = EngineConfig::fullStrength(12);
+        config.timeBudgetMs = getDifficultyProfile(4).timeBudgetMs;
+        _hint.start(std::make_shared<MNKGame>(_game), config, [this](const SearchResult& result) {
+            if (result.move >= 0)
+            {
+                _hintCell = result.move;
+                _isHintActive = true;
+                _hintStartTime = std::chrono::steady_clock::now();
+            }
+            reDraw();
+            });
+        reDraw();
+    }
+
+private:
+    MNKGame _game;
+    AIPlayer _aiPlayer;
+    HintSearch _hint;
+    gui::Sound _clickSound;
+    double _boardLeft = 0;
+    double _boardTop = 0;
+    double _cellSize = 0;
+    bool _aiMoveScheduled = false;
+    int _lastMove = -1;
+
+    int _winCounter = 0;
+    int _lossCounter = 0;
+    bool _countersUpdated = false;
+
+    // Button rects for click detection
+    gui::Rect _quitBtn;
+    gui::Rect _replayBtn;
+    gui::Rect _hintBtn;
+
+    // Callbacks parent can set to handle close/replay actions
+    std::function<void()> _onQuit;
+    std::function<void()> _onReplay;
+
+    // AI generation counter to invalidate pending AI moves when resetting/closing
+    int _aiGen = 0;
+
+    Player _humanPlayer = Player::X;
+    Player _AIrole = Player::O;
+
+    // Hover preview state
+    int _hoverRow = -1;
+    int _hoverCol = -1;
+
+    // Hint system
+    bool _isHintActive = false;
+    int _hintCell = -1;
+    std::chrono::steady_clock::time_point _hintStartTime;
+
+    // Win pulse animation
+    std::chrono::steady_clock::time_point _winPulseStartTime;
+
+    // Button hover states
+    bool _quitBtnHovered = false;
+    bool _replayBtnHovered = false;
+    bool _hintBtnHovered = false;
+};
@@ -6,6 +6,8 @@
 #include "StartView.h"     //This is the start view
 #include "TicTacToeView.h"
 #include "Connect4View.h"
+#include "MNKView.h"
+#include "QubicView.h"
 #include "ViewSettings.h"
 #include "ScoreManager.h"
 #include <functional>
@@ -135,6 +137,17 @@ protected:
                     new GameWindow<Connect4View>();
                     break;
                 }
+                case GameType::MNK:
+                {
+                    // Five in a row gets its own window as well.
+                    new GameWindow<MNKView>();
+                    break;
+                }
+                case GameType::Qubic:
+                {
+                    new GameWindow<QubicView>();
+                    break;
+                }
                 default:
                     break;
                 }
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read-only view of a whole file (mmap / MapViewOfFile), released on destruction.
+// data() is null if the file could not be opened or is empty.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return static_cast<const unsigned char*>(_data); }
+    std::size_t size() const { return _size; }
+
+private:
+    void* _data{ nullptr };
+    std::size_t _size{ 0 };
+#if defined(_WIN32)
+    void* _file{ nullptr };    // HANDLE
+    void* _mapping{ nullptr }; // HANDLE
+#else
+    int _fd{ -1 };
+#endif
+};
@@ -0,0 +1,366 @@
+#include "MonteCarlo.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	enum : std::uint8_t { kLeaf, kExpanding, kExpanded };
+
+	// Tree node shared by every search thread. The counters are relaxed atomics; firstChild and
+	// childCount are written once by the expanding thread before it publishes kExpanded.
+	// Trivially constructible so the arena can reserve memory without touching it.
+	struct Node
+	{
+		std::atomic<std::uint32_t> visits;   // includes the virtual losses of playouts in flight
+		std::atomic<std::uint32_t> halfWins; // 2 per win, 1 per draw, from mover's point of view
+		std::atomic<std::uint8_t> state;
+		Player mover;                        // who played move
+		std::uint16_t childCount;
+		std::uint32_t firstChild;
+		Game::Move move;
+		float prior;
+	};
+
+	// Bump allocator for the nodes of one tree. A node's children are one contiguous block
+	// addressed by index; the whole tree is released at once with the arena. Thread safe.
+	class NodeArena
+	{
+	public:
+		static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+		explicit NodeArena(std::size_t capacity)
+			: _nodes(new Node[capacity])
+			, _capacity(capacity)
+		{
+		}
+
+		// First index of count fresh nodes, or kNone when the arena is full
+		std::uint32_t allocate(std::size_t count)
+		{
+			const std::size_t first = _used.fetch_add(count, std::memory_order_relaxed);
+			if (first > _capacity || count > _capacity - first)
+				return kNone;
+			for (std::size_t i = first; i < first + count; ++i)
+			{
+				Node& node = _nodes[i];
+				node.visits.store(0, std::memory_order_relaxed);
+				node.halfWins.store(0, std::memory_order_relaxed);
+				node.state.store(kLeaf, std::memory_order_relaxed);
+				node.mover = Player::None;
+				node.childCount = 0;
+				node.firstChild = 0;
+				node.move = -1;
+				node.prior = 1.0f;
+			}
+			return static_cast<std::uint32_t>(first);
+		}
+
+		Node& operator[](std::uint32_t index) { return _nodes[index]; }
+
+	private:
+		std::unique_ptr<Node[]> _nodes;
+		std::size_t _capacity;
+		std::atomic<std::size_t> _used{ 0 };
+	};
+
+	struct Tree
+	{
+		Tree(std::size_t capacity, Player rootMover)
+			: arena(capacity)
+		{
+			root = arena.allocate(1);
+			arena[root].mover = rootMover;
+		}
+
+		NodeArena arena;
+		std::uint32_t root;
+	};
+
+	// Budgets shared by all search threads
+	struct Limits
+	{
+		std::uint64_t playouts = 0;
+		bool hasDeadline = false;
+		std::chrono::steady_clock::time_point deadline;
+		const std::atomic<bool>* stop = nullptr;
+		const std::atomic<bool>* cancel = nullptr;
+		std::atomic<std::uint64_t> claimed{ 0 };
+		std::atomic<std::uint64_t> done{ 0 };
+		std::atomic<bool> aborted{ false };
+	};
+
+	const std::size_t kMaxArenaNodes = std::size_t(1) << 20;
+	const std::uint64_t kDefaultPlayouts = 100000; // when neither budget is set
+	const std::uint32_t kVirtualLoss = 3;          // visits (all lost) a playout in flight adds to its path
+	const double kExploration = 1.4;               // UCB1 constant for rewards in [0, 1]
+	const double kPriorExploration = 1.5;          // PUCT constant
+	const double kPriorTemperature = 20.0;         // heuristic points per e-fold of prior weight
+
+	double winRate(std::uint32_t visits, std::uint32_t halfWins)
+	{
+		return visits ? halfWins / (2.0 * visits) : 0.5;
+	}
+
+	// Creates one child per legal move of state and publishes them. With priors, children get a
+	// softmax over the heuristic of the position each move leads to. Returns false if the arena
+	// is full; the caller still owns the node's kExpanding state then.
+	bool expand(NodeArena& arena, std::uint32_t index, const Game& state, bool priors)
+	{
+		const auto moves = state.getValidMoves();
+		if (moves.empty())
+			return false;
+		const std::uint32_t first = arena.allocate(moves.size());
+		if (first == NodeArena::kNone)
+			return false;
+
+		const Player mover = state.getCurrentPlayer();
+		std::vector<double> weights(moves.size(), 1.0);
+		if (priors)
+		{
+			std::vector<int> scores(moves.size());
+			for (size_t i = 0; i < moves.size(); ++i)
+			{
+				auto child = state.clone();
+				child->makeMove(moves[i]);
+				if (child->isGameOver())
+					scores[i] = (child->getWinner() == mover) ? 1000 : 0;
+				else
+					scores[i] = evaluateHeuristic(*child, mover);
+			}
+			const int top = *std::max_element(scores.begin(), scores.end());
+			for (size_t i = 0; i < moves.size(); ++i)
+				weights[i] = std::exp((scores[i] - top) / kPriorTemperature);
+		}
+
+		double total = 0.0;
+		for (double w : weights)
+			total += w;
+		for (size_t i = 0; i < moves.size(); ++i)
+		{
+			Node& child = arena[first + static_cast<std::uint32_t>(i)];
+			child.move = moves[i];
+			child.mover = mover;
+			child.prior = static_cast<float>(weights[i] / total);
+		}
+
+		Node& node = arena[index];
+		node.firstChild = first;
+		node.childCount = static_cast<std::uint16_t>(moves.size());
+		node.state.store(kExpanded, std::memory_order_release);
+		return true;
+	}
+
+	// UCB1 (unvisited children first) or, with priors, PUCT
+	std::uint32_t selectChild(NodeArena& arena, std::uint32_t index, bool priors)
+	{
+		const Node& parent = arena[index];
+		const std::uint32_t parentVisits = std::max<std::uint32_t>(1, parent.visits.load(std::memory_order_relaxed));
+		const double logVisits = std::log(static_cast<double>(parentVisits));
+		const double sqrtVisits = std::sqrt(static_cast<double>(parentVisits));
+
+		std::uint32_t best = parent.firstChild;
+		double bestValue = -std::numeric_limits<double>::infinity();
+		for (std::uint32_t i = parent.firstChild; i < parent.firstChild + parent.childCount; ++i)
+		{
+			const Node& child = arena[i];
+			const std::uint32_t visits = child.visits.load(std::memory_order_relaxed);
+			const double q = winRate(visits, child.halfWins.load(std::memory_order_relaxed));
+			double value;
+			if (priors)
+			{
+				value = q + kPriorExploration * child.prior * sqrtVisits / (1.0 + visits);
+			}
+			else
+			{
+				if (visits == 0)
+					return i;
+				value = q + kExploration * std::sqrt(logVisits / visits);
+			}
+
+			if (value > bestValue)
+			{
+				bestValue = value;
+				best = i;
+			}
+		}
+		return best;
+	}
+
+	bool shouldStop(Limits& limits, std::uint64_t localPlayouts)
+	{
+		if ((limits.stop && limits.stop->load(std::memory_order_relaxed))
+			|| (limits.cancel && limits.cancel->load(std::memory_order_relaxed)))
+		{
+			limits.aborted = true;
+			return true;
+		}
+		return limits.hasDeadline && (localPlayouts & 63) == 0 && std::chrono::steady_clock::now() >= limits.deadline;
+	}
+
+	// Runs playouts on tree until the shared limits are used up. Returns the deepest path seen.
+	int runPlayouts(Tree& tree, const Game& game, bool priors, Limits& limits, unsigned seed)
+	{
+		NodeArena& arena = tree.arena;
+		std::mt19937 rng(seed);
+		std::vector<std::uint32_t> path;
+		int deepest = 0;
+		for (std::uint64_t local = 0;; ++local)
+		{
+			if (shouldStop(limits, local) || limits.claimed.fetch_add(1, std::memory_order_relaxed) >= limits.playouts)
+				break;
+
+			// Selection, adding a virtual loss to every node on the way so concurrent playouts
+			// spread over different lines
+			auto state = game.clone();
+			std::uint32_t index = tree.root;
+			arena[index].visits.fetch_add(kVirtualLoss, std::memory_order_relaxed);
+			path.assign(1, index);
+			while (arena[index].state.load(std::memory_order_acquire) == kExpanded)
+			{
+				index = selectChild(arena, index, priors);
+				arena[index].visits.fetch_add(kVirtualLoss, std::memory_order_relaxed);
+				state->makeMove(arena[index].move);
+				path.push_back(index);
+			}
+
+			// Expansion: a leaf is expanded once it has been visited before (the root right away).
+			// One thread claims it; the others play out from the leaf until it is published.
+			Node& leaf = arena[index];
+			if (!state->isGameOver() && (index == tree.root || leaf.visits.load(std::memory_order_relaxed) > kVirtualLoss))
+			{
+				std::uint8_t expected = kLeaf;
+				if (leaf.state.compare_exchange_strong(expected, kExpanding, std::memory_order_acq_rel))
+				{
+					if (expand(arena, index, *state, priors))
+					{
+						index = selectChild(arena, index, priors);
+						arena[index].visits.fetch_add(kVirtualLoss, std::memory_order_relaxed);
+						state->makeMove(arena[index].move);
+						path.push_back(index);
+					}
+					else
+					{
+						leaf.state.store(kLeaf, std::memory_order_release);
+					}
+				}
+			}
+			deepest = std::max(deepest, static_cast<int>(path.size()) - 1);
+
+			// Simulation and backpropagation: replace the virtual loss by one real visit
+			const Player winner = state->isGameOver() ? state->getWinner() : state->randomPlayout(rng);
+			for (std::uint32_t i : path)
+			{
+				Node& node = arena[i];
+				const std::uint32_t reward = (winner == Player::None) ? 1 : (winner == node.mover ? 2 : 0);
+				node.halfWins.fetch_add(reward, std::memory_order_relaxed);
+				node.visits.fetch_sub(kVirtualLoss - 1, std::memory_order_relaxed);
+			}
+			limits.done.fetch_add(1, std::memory_order_relaxed);
+		}
+		return deepest;
+	}
+
+	struct RootStats
+	{
+		Game::Move move;
+		std::uint64_t visits;
+		std::uint64_t halfWins;
+	};
+
+	// Adds the root children of tree to stats, matched by move
+	void mergeRoot(Tree& tree, std::vector<RootStats>& stats)
+	{
+		Node& root = tree.arena[tree.root];
+		if (root.state.load(std::memory_order_acquire) != kExpanded)
+			return;
+		for (std::uint32_t i = root.firstChild; i < root.firstChild + root.childCount; ++i)
+		{
+			const Node& child = tree.arena[i];
+			for (auto& s : stats)
+			{
+				if (s.move == child.move)
+				{
+					s.visits += child.visits.load(std::memory_order_relaxed);
+					s.halfWins += child.halfWins.load(std::memory_order_relaxed);
+				}
+			}
+		}
+	}
+}
+
+SearchResult searchMonteCarlo(const Game& game, const EngineConfig& config, const std::atomic<bool>* stop)
+{
+	SearchResult result;
+	const auto rootMoves = game.getValidMoves();
+	if (game.isGameOver() || rootMoves.empty())
+		return result;
+	result.move = rootMoves.front();
+
+	Limits limits;
+	limits.playouts = config.nodeBudget;
+	if (limits.playouts == 0)
+		limits.playouts = (config.timeBudgetMs > 0) ? std::numeric_limits<std::uint64_t>::max() : kDefaultPlayouts;
+	limits.hasDeadline = config.timeBudgetMs > 0;
+	limits.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(config.timeBudgetMs);
+	limits.stop = stop;
+	limits.cancel = config.cancel;
+
+	// Each playout adds at most one expansion, and branching never grows beyond the root's here.
+	// Root-parallel trees split that capacity between them.
+	const int threads = std::max(1, config.threads);
+	const int trees = config.mctsRootParallel ? threads : 1;
+	const std::uint64_t expansions = std::min<std::uint64_t>(limits.playouts, kMaxArenaNodes) + threads;
+	const std::size_t capacity = static_cast<std::size_t>(std::min<std::uint64_t>(kMaxArenaNodes, expansions * rootMoves.size() + 1));
+	const Player rootMover = (game.getCurrentPlayer() == Player::X) ? Player::O : Player::X;
+
+	std::vector<std::unique_ptr<Tree>> forest;
+	for (int t = 0; t < trees; ++t)
+		forest.push_back(std::make_unique<Tree>(capacity / trees + rootMoves.size() + 1, rootMover));
+
+	std::random_device rd;
+	std::vector<int> deepest(threads, 0);
+	std::vector<std::thread> workers;
+	for (int t = 1; t < threads; ++t)
+	{
+		const unsigned seed = rd();
+		workers.emplace_back([&, t, seed]() {
+			deepest[t] = runPlayouts(*forest[t % trees], game, config.mctsPriors, limits, seed);
+			});
+	}
+	deepest[0] = runPlayouts(*forest[0], game, config.mctsPriors, limits, rd());
+	for (auto& w : workers)
+		w.join();
+
+	result.nodes = limits.done.load();
+	result.depth = *std::max_element(deepest.begin(), deepest.end());
+	result.aborted = limits.aborted.load();
+
+	std::vector<RootStats> stats;
+	for (Game::Move move : rootMoves)
+		stats.push_back({ move, 0, 0 });
+	for (auto& tree : forest)
+		mergeRoot(*tree, stats);
+
+	// Most visited child; the better win rate breaks ties
+	const RootStats* best = nullptr;
+	for (const auto& s : stats)
+	{
+		if (s.visits == 0)
+			continue;
+		const double q = static_cast<double>(s.halfWins) / (2.0 * s.visits);
+		if (!best || s.visits > best->visits
+			|| (s.visits == best->visits && q > static_cast<double>(best->halfWins) / (2.0 * best->visits)))
+			best = &s;
+	}
+	if (!best)
+		return result;
+	result.move = best->move;
+	result.score = static_cast<int>(std::lround((2.0 * best->halfWins / (2.0 * best->visits) - 1.0) * 100.0));
+	return result;
+}
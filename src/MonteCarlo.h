@@ -0,0 +1,19 @@
+#pragma once
+#include <atomic>
+#include "AIPlayer.h"
+
+// Monte Carlo tree search (UCT) over the Game interface. Each playout descends the tree, expands
+// a leaf, finishes the game with Game::randomPlayout and backs the result up the path. The move
+// played is the most visited root child.
+//
+// config.nodeBudget counts playouts and config.timeBudgetMs bounds the wall time; with neither set
+// a fixed playout count is used. config.mctsPriors biases selection towards children that
+// evaluateHeuristic likes (PUCT); without it plain UCB1 is used. SearchResult::nodes reports the
+// playouts run, depth the deepest tree path and score the best child's win rate mapped to
+// -100..100 (never a proven +/-1000).
+//
+// config.threads workers share one tree: counters are atomic, a playout in flight adds a virtual
+// loss to its path so the others pick different lines, and a leaf is expanded by whichever thread
+// claims it first, with nodes bump-allocated from a per-search arena. With config.mctsRootParallel
+// every thread grows its own tree instead and the root children's statistics are summed.
+SearchResult searchMonteCarlo(const Game& game, const EngineConfig& config, const std::atomic<bool>* stop);
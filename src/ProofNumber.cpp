@@ -0,0 +1,289 @@
+#include "ProofNumber.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+
+namespace
+{
+	const std::uint32_t kInfinity = 1u << 30;
+	const std::uint64_t kAttackerO = 0x9E3779B97F4A7C15ULL; // keeps the two attackers' entries apart
+
+	std::uint32_t saturatingAdd(std::uint32_t a, std::uint32_t b)
+	{
+		return std::min<std::uint64_t>(std::uint64_t(a) + b, kInfinity);
+	}
+
+	std::uint64_t keyOf(const Game& game, Player attacker)
+	{
+		return game.getKey() ^ (attacker == Player::O ? kAttackerO : 0);
+	}
+
+	std::size_t mix(std::uint64_t key)
+	{
+		// splitmix64 finalizer, as in TranspositionTable
+		key ^= key >> 30;
+		key *= 0xBF58476D1CE4E5B9ULL;
+		key ^= key >> 27;
+		key *= 0x94D049BB133111EBULL;
+		key ^= key >> 31;
+		return static_cast<std::size_t>(key);
+	}
+}
+
+struct ProofSearch::Limits
+{
+	std::uint64_t nodes = 0;
+	std::uint64_t nodeLimit = 0;
+	bool hasDeadline = false;
+	std::chrono::steady_clock::time_point deadline;
+	const std::atomic<bool>* stop = nullptr;
+	const std::atomic<bool>* cancel = nullptr;
+	bool aborted = false;
+
+	bool exhausted()
+	{
+		if (!aborted)
+		{
+			aborted = (nodeLimit && nodes >= nodeLimit)
+				|| (stop && stop->load(std::memory_order_relaxed))
+				|| (cancel && cancel->load(std::memory_order_relaxed))
+				|| (hasDeadline && (nodes & 1023) == 0 && std::chrono::steady_clock::now() >= deadline);
+		}
+		return aborted;
+	}
+};
+
+ProofSearch::ProofSearch(std::size_t megabytes)
+{
+	const std::size_t bytes = std::max<std::size_t>(1, megabytes) << 20;
+	std::size_t buckets = 1;
+	while (buckets * 2 * kEntriesPerBucket * sizeof(Entry) <= bytes)
+		buckets *= 2;
+	_entries.resize(buckets * kEntriesPerBucket);
+	_bucketMask = buckets - 1;
+}
+
+void ProofSearch::clear()
+{
+	std::fill(_entries.begin(), _entries.end(), Entry());
+}
+
+const ProofSearch::Entry* ProofSearch::lookup(std::uint64_t key) const
+{
+	const Entry* bucket = &_entries[(mix(key) & _bucketMask) * kEntriesPerBucket];
+	for (std::size_t i = 0; i < kEntriesPerBucket; ++i)
+	{
+		if (bucket[i].work && bucket[i].key == key)
+			return &bucket[i];
+	}
+	return nullptr;
+}
+
+void ProofSearch::store(std::uint64_t key, std::uint32_t pn, std::uint32_t dn, std::uint64_t work)
+{
+	// Same key, else an empty slot, else the entry that took the least work to compute
+	Entry* bucket = &_entries[(mix(key) & _bucketMask) * kEntriesPerBucket];
+	Entry* victim = bucket;
+	for (std::size_t i = 0; i < kEntriesPerBucket; ++i)
+	{
+		Entry& e = bucket[i];
+		if (e.work == 0 || e.key == key)
+		{
+			victim = &e;
+			break;
+		}
+		if (e.work < victim->work)
+			victim = &e;
+	}
+	victim->key = key;
+	victim->pn = pn;
+	victim->dn = dn;
+	victim->work = static_cast<std::uint32_t>(std::min<std::uint64_t>(std::max<std::uint64_t>(work, 1), std::numeric_limits<std::uint32_t>::max()));
+}
+
+// Multiple-iterative-deepening step of df-pn: works on node until its proof number reaches
+// thresholdPn or its disproof number reaches thresholdDn, then stores both. OR nodes have the
+// attacker to move. Returns the number of nodes expanded.
+std::uint64_t ProofSearch::search(const Game& node, Player attacker, std::uint32_t thresholdPn, std::uint32_t thresholdDn,
+	Limits& limits)
+{
+	const std::uint64_t key = keyOf(node, attacker);
+	const Player mover = node.getCurrentPlayer();
+	const bool orNode = (mover == attacker);
+	const auto moves = node.getValidMoves();
+	++limits.nodes;
+	std::uint64_t work = 1;
+
+	// A line the mover completes right away decides the node without expanding it
+	for (Game::Move move : moves)
+	{
+		if (node.isWinningMove(mover, move))
+		{
+			store(key, orNode ? 0 : kInfinity, orNode ? kInfinity : 0, work);
+			return work;
+		}
+	}
+
+	std::vector<std::unique_ptr<Game>> children;
+	children.reserve(moves.size());
+	for (Game::Move move : moves)
+	{
+		children.push_back(node.clone());
+		children.back()->makeMove(move);
+	}
+
+	std::uint32_t pn = 0;
+	std::uint32_t dn = 0;
+	while (true)
+	{
+		// OR: pn = min over children, dn = sum; AND: the other way round. best is the child with
+		// the smallest number being minimized, second the runner-up value.
+		pn = orNode ? kInfinity : 0;
+		dn = orNode ? 0 : kInfinity;
+		size_t best = 0;
+		std::uint32_t bestValue = kInfinity;
+		std::uint32_t second = kInfinity;
+		std::uint32_t bestPn = kInfinity;
+		std::uint32_t bestDn = 0;
+		for (size_t i = 0; i < children.size(); ++i)
+		{
+			// A finished child is a draw here (wins were caught above): never a win for the attacker
+			std::uint32_t childPn = kInfinity;
+			std::uint32_t childDn = 0;
+			if (!children[i]->isGameOver())
+			{
+				const Entry* entry = lookup(keyOf(*children[i], attacker));
+				childPn = entry ? entry->pn : 1;
+				childDn = entry ? entry->dn : 1;
+			}
+
+			const std::uint32_t value = orNode ? childPn : childDn;
+			if (orNode)
+			{
+				pn = std::min(pn, childPn);
+				dn = saturatingAdd(dn, childDn);
+			}
+			else
+			{
+				pn = saturatingAdd(pn, childPn);
+				dn = std::min(dn, childDn);
+			}
+			if (value < bestValue)
+			{
+				second = bestValue;
+				bestValue = value;
+				best = i;
+				bestPn = childPn;
+				bestDn = childDn;
+			}
+			else if (value < second)
+			{
+				second = value;
+			}
+		}
+
+		if (pn >= thresholdPn || dn >= thresholdDn || pn == 0 || dn == 0 || limits.exhausted())
+			break;
+
+		// The 1 + 1/4 margin over the runner-up keeps the search from switching back and forth
+		// between siblings of similar cost
+		const std::uint32_t margin = saturatingAdd(second, second / 4 + 1);
+		std::uint32_t childPn;
+		std::uint32_t childDn;
+		if (orNode)
+		{
+			childPn = std::min(thresholdPn, margin);
+			childDn = saturatingAdd(thresholdDn - dn, bestDn);
+		}
+		else
+		{
+			childDn = std::min(thresholdDn, margin);
+			childPn = saturatingAdd(thresholdPn - pn, bestPn);
+		}
+		work += search(*children[best], attacker, childPn, childDn, limits);
+	}
+
+	store(key, pn, dn, work);
+	return work;
+}
+
+ProofSearch::Outcome ProofSearch::solve(const Game& game, Player attacker, Limits& limits)
+{
+	const std::uint64_t key = keyOf(game, attacker);
+	const Entry* entry = lookup(key);
+	if (!entry || (entry->pn != 0 && entry->dn != 0))
+	{
+		search(game, attacker, kInfinity, kInfinity, limits);
+		entry = lookup(key);
+	}
+	if (entry && entry->pn == 0)
+		return Outcome::Proven;
+	if (entry && entry->dn == 0)
+		return Outcome::Disproven;
+	return Outcome::Open;
+}
+
+// Immediate win if there is one, else the proven child that took the least work to prove
+Game::Move ProofSearch::winningMove(const Game& game) const
+{
+	const Player mover = game.getCurrentPlayer();
+	const auto moves = game.getValidMoves();
+	for (Game::Move move : moves)
+	{
+		if (game.isWinningMove(mover, move))
+			return move;
+	}
+
+	Game::Move best = -1;
+	std::uint32_t bestWork = std::numeric_limits<std::uint32_t>::max();
+	for (Game::Move move : moves)
+	{
+		auto child = game.clone();
+		child->makeMove(move);
+		const Entry* entry = child->isGameOver() ? nullptr : lookup(keyOf(*child, mover));
+		if (entry && entry->pn == 0 && entry->work < bestWork)
+		{
+			best = move;
+			bestWork = entry->work;
+		}
+	}
+	return best;
+}
+
+ProofSearch::Result ProofSearch::prove(const Game& game, std::uint64_t nodeLimit, int timeBudgetMs,
+	const std::atomic<bool>* stop, const std::atomic<bool>* cancel)
+{
+	Result result;
+	if (game.isGameOver())
+		return result;
+
+	Limits limits;
+	limits.nodeLimit = nodeLimit;
+	limits.hasDeadline = timeBudgetMs > 0;
+	limits.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeBudgetMs);
+	limits.stop = stop;
+	limits.cancel = cancel;
+
+	// First "the side to move wins"; once that is refuted, "the opponent wins" tells a loss
+	// from a draw
+	const Player mover = game.getCurrentPlayer();
+	const Player opponent = (mover == Player::X) ? Player::O : Player::X;
+	const Outcome own = solve(game, mover, limits);
+	if (own == Outcome::Proven)
+	{
+		result.move = winningMove(game);
+		if (result.move >= 0)
+			result.value = Value::Win;
+	}
+	else if (own == Outcome::Disproven)
+	{
+		const Outcome theirs = solve(game, opponent, limits);
+		if (theirs == Outcome::Proven)
+			result.value = Value::Loss;
+		else if (theirs == Outcome::Disproven)
+			result.value = Value::Draw;
+	}
+	result.nodes = limits.nodes;
+	return result;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AIPlayer.h"
+
+// Depth-first proof-number search (df-pn) over the Game interface. It proves or disproves
+// "the attacker wins" best-first, following the cheapest open lines, so it finds long forced wins
+// that a fixed-depth alpha-beta search cannot see. Results live in a bounded table of its own that
+// survives between calls: once a position is proven, the winning line is read back from the table
+// move by move without searching again.
+class ProofSearch
+{
+public:
+    // Outcome for the side to move under perfect play, when proven.
+    enum class Value
+    {
+        Unknown, // out of budget
+        Win,
+        Loss,
+        Draw
+    };
+
+    struct Result
+    {
+        Value value{ Value::Unknown };
+        Game::Move move{ -1 }; // a winning move when value is Win
+        std::uint64_t nodes{ 0 };
+    };
+
+    static constexpr std::size_t kDefaultMegabytes = 2;
+
+    explicit ProofSearch(std::size_t megabytes = kDefaultMegabytes);
+
+    // Tries to prove the game's outcome within nodeLimit expanded nodes and timeBudgetMs
+    // (0 = unlimited). Either flag aborts the attempt when set; work done so far stays in the table.
+    Result prove(const Game& game, std::uint64_t nodeLimit, int timeBudgetMs,
+        const std::atomic<bool>* stop = nullptr, const std::atomic<bool>* cancel = nullptr);
+
+    void clear();
+
+private:
+    // Proof and disproof numbers of one position for one attacker
+    struct Entry
+    {
+        std::uint64_t key{ 0 };
+        std::uint32_t pn{ 0 };
+        std::uint32_t dn{ 0 };
+        std::uint32_t work{ 0 }; // nodes expanded below this entry; 0 = empty slot
+    };
+
+    struct Limits;
+    enum class Outcome { Open, Proven, Disproven };
+
+    static constexpr std::size_t kEntriesPerBucket = 4;
+
+    const Entry* lookup(std::uint64_t key) const;
+    void store(std::uint64_t key, std::uint32_t pn, std::uint32_t dn, std::uint64_t work);
+    Outcome solve(const Game& game, Player attacker, Limits& limits);
+    std::uint64_t search(const Game& node, Player attacker, std::uint32_t thresholdPn, std::uint32_t thresholdDn,
+        Limits& limits);
+    Game::Move winningMove(const Game& game) const;
+
+    std::vector<Entry> _entries;
+    std::size_t _bucketMask{ 0 };
+};
@@ -0,0 +1,340 @@
+#pragma once
+#include "AIPlayer.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Qubic: four in a row on a 4x4x4 cube. Each player's stones are one 64-bit word, bit
+// z * 16 + y * 4 + x per cell, which is also the move index (layer z, row y, column x). The 76
+// winning lines (rows, columns and pillars, the diagonals of every plane and the 4 space
+// diagonals) are precomputed masks; a win or a line count is an AND and a popcount.
+class Qubic : public Game
+{
+public:
+    static constexpr int kSide = 4;
+    static constexpr int kCells = 64;
+    static constexpr int kLines = 76;
+
+    Qubic() = default;
+
+    std::unique_ptr<Game> clone() const override
+    {
+        return std::make_unique<Qubic>(*this);
+    }
+
+    // Empty cells, the 16 strong cells (corners and the inner cube, on 7 lines each) first
+    std::vector<Move> getValidMoves() const override
+    {
+        std::vector<Move> moves;
+        if (_gameOver)
+            return moves;
+        const std::uint64_t empty = ~(_stones[0] | _stones[1]);
+        moves.reserve(kCells - _count);
+        for (int cell : tables().order)
+        {
+            if (empty & bit(cell))
+                moves.push_back(cell);
+        }
+        return moves;
+    }
+
+    Player checkWin() const override { return _lineWinner; }
+
+    bool isDraw() const override
+    {
+        return _lineWinner == Player::None && _count == kCells;
+    }
+
+    // Hash of both stone words and the side to move. Bits 63 and 61 set, 62 clear: apart from
+    // Tic-Tac-Toe (63 only), Connect 4 (63 clear) and m,n,k keys (63 and 62).
+    std::uint64_t getKey() const override
+    {
+        return keyOf(_stones[0], _stones[1]);
+    }
+
+    // Smallest key over the 48 rotations and reflections of the cube while few stones are on
+    // it (the cost grows with the stones); later positions rarely recur mirrored, so their key
+    // is the plain one. Symmetric positions have equal stone counts, so they agree either way.
+    std::uint64_t getCanonicalKey(int& symmetry) const override
+    {
+        symmetry = 0;
+        std::uint64_t best = getKey();
+        if (_count > kSymmetricStones)
+            return best;
+        const Tables& t = tables();
+        for (int s = 1; s < kSymmetries; ++s)
+        {
+            const std::uint64_t key = keyOf(transform(_stones[0], t.forward[s]), transform(_stones[1], t.forward[s]));
+            if (key < best)
+            {
+                best = key;
+                symmetry = s;
+            }
+        }
+        return best;
+    }
+
+    Move toCanonicalMove(Move move, int symmetry) const override
+    {
+        if (move < 0 || move >= kCells || symmetry <= 0 || symmetry >= kSymmetries)
+            return move;
+        return tables().forward[symmetry][move];
+    }
+
+    Move fromCanonicalMove(Move move, int symmetry) const override
+    {
+        if (move < 0 || move >= kCells || symmetry <= 0 || symmetry >= kSymmetries)
+            return move;
+        return tables().inverse[symmetry][move];
+    }
+
+    bool isWinningMove(Player player, Move move) const override
+    {
+        if (move < 0 || move >= kCells || ((_stones[0] | _stones[1]) & bit(move)) || player == Player::None)
+            return false;
+        const int me = sideOf(player);
+        const Tables& t = tables();
+        for (int i = 0; i < t.lineCount[move]; ++i)
+        {
+            const std::uint64_t mask = t.lines[t.linesThrough[move][i]];
+            if ((_stones[1 - me] & mask) == 0 && popcount(_stones[me] & mask) == kSide - 1)
+                return true;
+        }
+        return false;
+    }
+
+    // Random game to the end on the two stone words
+    Player randomPlayout(std::mt19937& rng) const override
+    {
+        if (_gameOver)
+            return _winner;
+
+        std::uint64_t stones[2] = { _stones[0], _stones[1] };
+        int side = sideOf(_currentPlayer);
+        const Tables& t = tables();
+        for (int count = _count; count < kCells; ++count, side ^= 1)
+        {
+            // Pick the n-th empty cell
+            std::uint64_t empty = ~(stones[0] | stones[1]);
+            for (int n = static_cast<int>(rng() % static_cast<unsigned>(kCells - count)); n > 0; --n)
+                empty &= empty - 1;
+            const int cell = lowestBit(empty);
+            stones[side] |= bit(cell);
+            for (int i = 0; i < t.lineCount[cell]; ++i)
+            {
+                const std::uint64_t mask = t.lines[t.linesThrough[cell][i]];
+                if ((stones[side] & mask) == mask)
+                    return side == 0 ? Player::X : Player::O;
+            }
+        }
+        return Player::None;
+    }
+
+    // Open lines of each player weighted by how full they are (1, 4, 32 for 1..3 stones), kept
+    // up to date move by move; from player's point of view, clamped below the search's win scores.
+    int evaluate(Player player) const
+    {
+        const int me = sideOf(player);
+        return std::clamp(_score[me] - _score[1 - me], -kMaxEval, kMaxEval);
+    }
+
+    // Getter for the UI: cell (x, y) of layer z
+    Player getCell(int layer, int row, int col) const
+    {
+        if (layer < 0 || layer >= kSide || row < 0 || row >= kSide || col < 0 || col >= kSide)
+            return Player::None;
+        const std::uint64_t b = bit(layer * 16 + row * 4 + col);
+        return (_stones[0] & b) ? Player::X : (_stones[1] & b) ? Player::O : Player::None;
+    }
+
+    int stoneCount() const { return _count; }
+
+    // Cells of the completed line (bit mask), 0 while nobody has won
+    std::uint64_t winningLine() const { return _winningLine; }
+
+protected:
+    bool placeMove(Player player, Move move) override
+    {
+        if (move < 0 || move >= kCells || player == Player::None)
+            return false;
+        const std::uint64_t b = bit(move);
+        if ((_stones[0] | _stones[1]) & b)
+            return false;
+
+        // Each line through the cell gains for its owner, or dies for the opponent
+        const int me = sideOf(player);
+        const Tables& t = tables();
+        for (int i = 0; i < t.lineCount[move]; ++i)
+        {
+            const std::uint64_t mask = t.lines[t.linesThrough[move][i]];
+            const int own = popcount(_stones[me] & mask);
+            const int other = popcount(_stones[1 - me] & mask);
+            if (other == 0)
+            {
+                _score[me] += kLineWeight[own + 1] - kLineWeight[own];
+                if (own + 1 == kSide && _lineWinner == Player::None)
+                {
+                    _lineWinner = player;
+                    _winningLine = mask;
+                }
+            }
+            else if (own == 0)
+            {
+                _score[1 - me] -= kLineWeight[other];
+            }
+        }
+        _stones[me] |= b;
+        ++_count;
+        return true;
+    }
+
+    void clearBoard() override
+    {
+        _stones[0] = _stones[1] = 0;
+        _score[0] = _score[1] = 0;
+        _count = 0;
+        _lineWinner = Player::None;
+        _winningLine = 0;
+    }
+
+private:
+    static constexpr int kSymmetries = 48;
+    static constexpr int kSymmetricStones = 8;
+    static constexpr int kLineWeight[kSide + 1] = { 0, 1, 4, 32, 0 };
+    static constexpr int kMaxEval = 900;
+
+    struct Tables
+    {
+        std::array<std::uint64_t, kLines> lines{};
+        std::array<std::array<std::uint8_t, 7>, kCells> linesThrough{};
+        std::array<std::uint8_t, kCells> lineCount{};
+        std::array<std::uint8_t, kCells> order{};   // cells by lines through them, most first
+        std::array<std::array<std::uint8_t, kCells>, kSymmetries> forward{}; // cell -> cell in symmetry s
+        std::array<std::array<std::uint8_t, kCells>, kSymmetries> inverse{};
+
+        Tables()
+        {
+            // Every direction once (the first nonzero step is positive), from every cell whose
+            // line stays inside the cube
+            int count = 0;
+            for (int d = 0; d < 27; ++d)
+            {
+                const int dx = d % 3 - 1, dy = (d / 3) % 3 - 1, dz = d / 9 - 1;
+                const int first = dz != 0 ? dz : dy != 0 ? dy : dx;
+                if (first <= 0)
+                    continue;
+                for (int start = 0; start < kCells; ++start)
+                {
+                    const int x = start % 4, y = (start / 4) % 4, z = start / 16;
+                    const int ex = x + 3 * dx, ey = y + 3 * dy, ez = z + 3 * dz;
+                    if (ex < 0 || ex >= kSide || ey < 0 || ey >= kSide || ez < 0 || ez >= kSide)
+                        continue;
+                    std::uint64_t mask = 0;
+                    for (int i = 0; i < kSide; ++i)
+                    {
+                        const int cell = (z + i * dz) * 16 + (y + i * dy) * 4 + (x + i * dx);
+                        mask |= bit(cell);
+                        linesThrough[cell][lineCount[cell]++] = static_cast<std::uint8_t>(count);
+                    }
+                    lines[count++] = mask;
+                }
+            }
+
+            for (int i = 0; i < kCells; ++i)
+                order[i] = static_cast<std::uint8_t>(i);
+            std::stable_sort(order.begin(), order.end(), [this](std::uint8_t a, std::uint8_t b) {
+                return lineCount[a] > lineCount[b];
+            });
+
+            // Axis permutations times reflections
+            const int perms[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+            for (int s = 0; s < kSymmetries; ++s)
+            {
+                const int* perm = perms[s / 8];
+                const int flips = s % 8;
+                for (int cell = 0; cell < kCells; ++cell)
+                {
+                    const int c[3] = { cell % 4, (cell / 4) % 4, cell / 16 };
+                    int t[3];
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        t[axis] = c[perm[axis]];
+                        if (flips & (1 << axis))
+                            t[axis] = kSide - 1 - t[axis];
+                    }
+                    const int image = t[2] * 16 + t[1] * 4 + t[0];
+                    forward[s][cell] = static_cast<std::uint8_t>(image);
+                    inverse[s][image] = static_cast<std::uint8_t>(cell);
+                }
+            }
+        }
+    };
+
+    static const Tables& tables()
+    {
+        static const Tables t;
+        return t;
+    }
+
+    static constexpr std::uint64_t bit(int cell) { return std::uint64_t(1) << cell; }
+
+    static int sideOf(Player player) { return player == Player::X ? 0 : 1; }
+
+    static int popcount(std::uint64_t x)
+    {
+#if defined(_MSC_VER)
+        return static_cast<int>(__popcnt64(x));
+#else
+        return __builtin_popcountll(x);
+#endif
+    }
+
+    static int lowestBit(std::uint64_t x)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(x);
+#endif
+    }
+
+    static std::uint64_t transform(std::uint64_t stones, const std::array<std::uint8_t, kCells>& map)
+    {
+        std::uint64_t result = 0;
+        for (; stones; stones &= stones - 1)
+            result |= bit(map[lowestBit(stones)]);
+        return result;
+    }
+
+    std::uint64_t keyOf(std::uint64_t x, std::uint64_t o) const
+    {
+        // splitmix64 finalizer over both words
+        auto mix = [](std::uint64_t k) {
+            k ^= k >> 30;
+            k *= 0xBF58476D1CE4E5B9ULL;
+            k ^= k >> 27;
+            k *= 0x94D049BB133111EBULL;
+            k ^= k >> 31;
+            return k;
+        };
+        std::uint64_t key = mix(mix(x + 0x9E3779B97F4A7C15ULL) ^ o);
+        if (_currentPlayer == Player::O)
+            key = ~key;
+        return (key & ~(std::uint64_t(7) << 61)) | (std::uint64_t(5) << 61);
+    }
+
+    std::uint64_t _stones[2]{ 0, 0 }; // X, O
+    int _score[2]{ 0, 0 };
+    int _count{ 0 };
+    Player _lineWinner{ Player::None };
+    std::uint64_t _winningLine{ 0 };
+};
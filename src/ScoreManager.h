@@ -1,7 +1,10 @@
 #pragma once
 #include <gui/Application.h>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
 
-// Global persistent score manager for both games
+// Global persistent score manager for all games
 class ScoreManager
 {
 public:
@@ -17,8 +20,36 @@ public:
 		return instance;
 	}
 
+	// Path of a file in the per-user app data directory (created on demand), or empty if there is none
+	static std::string getDataFilePath(const char* fileName)
+	{
+		std::string dir;
+#if defined(_WIN32)
+		if (const char* appData = std::getenv("APPDATA"))
+			dir = std::string(appData) + "/ConnectXO";
+#elif defined(__APPLE__)
+		if (const char* home = std::getenv("HOME"))
+			dir = std::string(home) + "/Library/Application Support/ConnectXO";
+#else
+		if (const char* xdg = std::getenv("XDG_DATA_HOME"); xdg && *xdg)
+			dir = std::string(xdg) + "/ConnectXO";
+		else if (const char* home = std::getenv("HOME"))
+			dir = std::string(home) + "/.local/share/ConnectXO";
+#endif
+		if (dir.empty())
+			return std::string();
+
+		std::error_code ec;
+		std::filesystem::create_directories(dir, ec);
+		if (ec)
+			return std::string();
+		return dir + "/" + fileName;
+	}
+
 	GameStats& getTTTStats() { return _tttStats; }
 	GameStats& getC4Stats() { return _c4Stats; }
+	GameStats& getMNKStats() { return _mnkStats; }
+	GameStats& getQubicStats() { return _qubicStats; }
 
 	void resetTTTStats() 
 	{ 
@@ -32,6 +63,18 @@ public:
 		saveC4Stats();
 	}
 
+	void resetMNKStats() 
+	{ 
+		_mnkStats = GameStats();
+		saveMNKStats();
+	}
+
+	void resetQubicStats() 
+	{ 
+		_qubicStats = GameStats();
+		saveQubicStats();
+	}
+
 	// Load scores from app properties
 	void loadScores()
 	{
@@ -44,6 +87,10 @@ public:
 		_tttStats.losses = props->getValue("tttLosses", 0);
 		_c4Stats.wins = props->getValue("c4Wins", 0);
 		_c4Stats.losses = props->getValue("c4Losses", 0);
+		_mnkStats.wins = props->getValue("mnkWins", 0);
+		_mnkStats.losses = props->getValue("mnkLosses", 0);
+		_qubicStats.wins = props->getValue("qubicWins", 0);
+		_qubicStats.losses = props->getValue("qubicLosses", 0);
 	}
 
 	// Save Tic-Tac-Toe scores to app properties
@@ -70,6 +117,30 @@ public:
 		props->setValue("c4Losses", _c4Stats.losses);
 	}
 
+	// Save five-in-a-row scores to app properties
+	void saveMNKStats()
+	{
+		auto app = gui::getApplication();
+		if (!app) return;
+		auto props = app->getProperties();
+		if (!props) return;
+
+		props->setValue("mnkWins", _mnkStats.wins);
+		props->setValue("mnkLosses", _mnkStats.losses);
+	}
+
+	// Save Qubic scores to app properties
+	void saveQubicStats()
+	{
+		auto app = gui::getApplication();
+		if (!app) return;
+		auto props = app->getProperties();
+		if (!props) return;
+
+		props->setValue("qubicWins", _qubicStats.wins);
+		props->setValue("qubicLosses", _qubicStats.losses);
+	}
+
 private:
 	ScoreManager() 
 	{ 
@@ -77,5 +148,7 @@ private:
 	}
 	GameStats _tttStats;
 	GameStats _c4Stats;
+	GameStats _mnkStats;
+	GameStats _qubicStats;
 };
 
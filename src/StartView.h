@@ -13,18 +13,24 @@ extern "C" int getThemeIndex();
 enum class GameType
 {
     TicTacToe,
-    Connect4
+    Connect4,
+    MNK,
+    Qubic
 };
 
-// Start screen view with two clickable regions for game selection.
+// Start screen view with four clickable regions for game selection.
 class StartView : public gui::Canvas
 {
     std::function<void(GameType)> _onSelect;
     gui::Rect _ticTacToeRect;
     gui::Rect _connect4Rect;
+    gui::Rect _mnkRect;
+    gui::Rect _qubicRect;
     bool _layoutReady = false;
     bool _ticHovered = false;
     bool _connectHovered = false;
+    bool _mnkHovered = false;
+    bool _qubicHovered = false;
 
     gui::Image _ticImage;
     gui::Image _connectImage;
@@ -35,24 +41,27 @@ class StartView : public gui::Canvas
 
     void layoutRects(const gui::Size& newSize)
     {
-        const td::Coord gap = newSize.width * 0.10f;   // 10% horizontal gap
-        const td::Coord rectW = newSize.width * 0.35f; // each card 35% of width
-        const td::Coord rectH = newSize.height * 0.45f;
+        const td::Coord gap = newSize.width * 0.03f;   // 3% horizontal gap
+        const td::Coord rectW = newSize.width * 0.21f; // each card 21% of width
+        const td::Coord rectH = newSize.height * 0.40f;
         const td::Coord centerY = newSize.height * 0.55f;  // Moved up from 0.68f to reduce gap
 
-        const td::Coord leftX = (newSize.width * 0.5f) - rectW - gap * 0.5f;
-        const td::Coord rightX = (newSize.width * 0.5f) + gap * 0.5f;
+        const td::Coord firstX = (newSize.width - rectW * 4 - gap * 3) * 0.5f;
         const td::Coord top = centerY - rectH * 0.5f;
         const td::Coord bottom = centerY + rectH * 0.5f;
 
-        _ticTacToeRect = gui::Rect(leftX, top, leftX + rectW, bottom);
-        _connect4Rect = gui::Rect(rightX, top, rightX + rectW, bottom);
+        gui::Rect* cards[] = { &_ticTacToeRect, &_connect4Rect, &_mnkRect, &_qubicRect };
+        for (int i = 0; i < 4; ++i)
+        {
+            const td::Coord x = firstX + (rectW + gap) * i;
+            *cards[i] = gui::Rect(x, top, x + rectW, bottom);
+        }
         _layoutReady = true;
     }
 
     void ensureLayout()
     {
-        if (!_layoutReady || (_ticTacToeRect.width() <= 0) || (_connect4Rect.width() <= 0))
+        if (!_layoutReady || (_ticTacToeRect.width() <= 0) || (_connect4Rect.width() <= 0) || (_mnkRect.width() <= 0) || (_qubicRect.width() <= 0))
         {
             gui::Size sz;
             getSize(sz);          // match signature: void getSize(Size& sz) const;
@@ -76,10 +85,15 @@ protected:
 
         bool wasTicHovered = _ticHovered;
         bool wasConnectHovered = _connectHovered;
+        bool wasMnkHovered = _mnkHovered;
+        bool wasQubicHovered = _qubicHovered;
         _ticHovered = contains(_ticTacToeRect);
         _connectHovered = contains(_connect4Rect);
+        _mnkHovered = contains(_mnkRect);
+        _qubicHovered = contains(_qubicRect);
 
-        if (_ticHovered != wasTicHovered || _connectHovered != wasConnectHovered)
+        if (_ticHovered != wasTicHovered || _connectHovered != wasConnectHovered || _mnkHovered != wasMnkHovered ||
+            _qubicHovered != wasQubicHovered)
             reDraw();
     }
 
@@ -166,7 +180,7 @@ protected:
 
         ensureLayout();
 
-        // Draw centered localized title above the two option cards.
+        // Draw centered localized title above the option cards.
         td::String title = tr("chooseGame");
         std::string titleStr = title.c_str();
         std::string spacedTitle;
@@ -258,6 +272,81 @@ protected:
         drawImageInRect(_ticImage, _ticTacToeRect, tr("ticTacToe"), _ticHovered ? 1.05 : 1.0);
         drawImageInRect(_connectImage, _connect4Rect, tr("connectFour"), _connectHovered ? 1.05 : 1.0);
 
+        // There is no icon resource for five in a row: the card shows a small board with a winning
+        // diagonal, drawn in the theme colors.
+        {
+            gui::Image noImage;
+            drawImageInRect(noImage, _mnkRect, tr("mnkGame"), 1.0);
+
+            const double cardH = _mnkRect.height();
+            const double pad = std::max(_mnkRect.width(), cardH) * padFraction;
+            const double availW = _mnkRect.width() - 2.0 * pad;
+            const double availH = cardH - 2.0 * pad - cardH * 0.14;
+            double side = std::max(0.0, std::min(availW, availH));
+            if (_mnkHovered)
+                side *= 1.05;
+            const int lines = 7;
+            const double step = side / (lines - 1);
+            const double left = (_mnkRect.left + _mnkRect.right - side) * 0.5;
+            const double top = _mnkRect.top + pad + (availH - side) * 0.5;
+            for (int i = 0; i < lines; ++i)
+            {
+                gui::Shape::drawLine(gui::Point(left, top + i * step), gui::Point(left + side, top + i * step), rectColor, 1.0f);
+                gui::Shape::drawLine(gui::Point(left + i * step, top), gui::Point(left + i * step, top + side), rectColor, 1.0f);
+            }
+            const int stones[][3] = { { 1, 1, 0 }, { 2, 2, 0 }, { 3, 3, 0 }, { 4, 4, 0 }, { 5, 5, 0 },
+                { 1, 3, 1 }, { 2, 4, 1 }, { 4, 2, 1 }, { 3, 5, 1 } }; // row, column, player
+            for (const auto& stone : stones)
+            {
+                const double r = step * 0.38;
+                const double cx = left + stone[1] * step;
+                const double cy = top + stone[0] * step;
+                gui::Shape sh;
+                sh.createOval(gui::Rect(cx - r, cy - r, cx + r, cy + r), 1.0f);
+                sh.drawFill(stone[2] == 0 ? accentColor : secondaryColor);
+            }
+        }
+
+        // Qubic has no icon either: four 4x4 layers stacked with an offset and a space diagonal
+        // of stones, one per layer.
+        {
+            gui::Image noImage;
+            drawImageInRect(noImage, _qubicRect, tr("qubicGame"), 1.0);
+
+            const double cardH = _qubicRect.height();
+            const double pad = std::max(_qubicRect.width(), cardH) * padFraction;
+            const double availW = _qubicRect.width() - 2.0 * pad;
+            const double availH = cardH - 2.0 * pad - cardH * 0.14;
+            double size = std::max(0.0, std::min(availW, availH));
+            if (_qubicHovered)
+                size *= 1.05;
+            const double shift = size * 0.12;   // offset from one layer to the next
+            const double layer = size - shift * 3;
+            const double step = layer / 4;
+            const double left = (_qubicRect.left + _qubicRect.right - size) * 0.5;
+            const double top = _qubicRect.top + pad + (availH - size) * 0.5;
+            for (int z = 0; z < 4; ++z)
+            {
+                // Bottom layer at the lower left, drawn first
+                const double lx = left + z * shift;
+                const double ly = top + (3 - z) * shift;
+                gui::Shape shLayer;
+                shLayer.createRect(gui::Rect(lx, ly, lx + layer, ly + layer));
+                shLayer.drawFillAndWire(cardFillColor, rectColor, 1.0f);
+                for (int i = 1; i < 4; ++i)
+                {
+                    gui::Shape::drawLine(gui::Point(lx, ly + i * step), gui::Point(lx + layer, ly + i * step), rectColor, 1.0f);
+                    gui::Shape::drawLine(gui::Point(lx + i * step, ly), gui::Point(lx + i * step, ly + layer), rectColor, 1.0f);
+                }
+                const double r = step * 0.36;
+                const double cx = lx + (z + 0.5) * step;
+                const double cy = ly + (z + 0.5) * step;
+                gui::Shape sh;
+                sh.createOval(gui::Rect(cx - r, cy - r, cx + r, cy + r), 1.0f);
+                sh.drawFill(accentColor);
+            }
+        }
+
         // Draw card borders (outline-only)
         {
             gui::Shape sh;
@@ -271,6 +360,18 @@ protected:
             sh.createRoundedRect(_connect4Rect, radius, 1.0f);
             sh.drawWire(_connectHovered ? rectBorderHoverColor : rectBorderColor, 3.0f);
         }
+        {
+            gui::Shape sh;
+            td::Coord radius = 20;
+            sh.createRoundedRect(_mnkRect, radius, 1.0f);
+            sh.drawWire(_mnkHovered ? rectBorderHoverColor : rectBorderColor, 3.0f);
+        }
+        {
+            gui::Shape sh;
+            td::Coord radius = 20;
+            sh.createRoundedRect(_qubicRect, radius, 1.0f);
+            sh.drawWire(_qubicHovered ? rectBorderHoverColor : rectBorderColor, 3.0f);
+        }
     }
 
     void onPrimaryButtonReleased(const gui::InputDevice& inputDevice) override
@@ -307,6 +408,32 @@ protected:
             }
             return;
         }
+
+        if (contains(_mnkRect))
+        {
+            if (_onSelect)
+            {
+                auto cb = _onSelect; // copy to avoid capturing a soon-to-be-destroyed view
+                auto* fn = new gui::AsyncFn([cb]() {
+                    cb(GameType::MNK);
+                    });
+                gui::NatObject::asyncCall(fn, true);
+            }
+            return;
+        }
+
+        if (contains(_qubicRect))
+        {
+            if (_onSelect)
+            {
+                auto cb = _onSelect; // copy to avoid capturing a soon-to-be-destroyed view
+                auto* fn = new gui::AsyncFn([cb]() {
+                    cb(GameType::Qubic);
+                    });
+                gui::NatObject::asyncCall(fn, true);
+            }
+            return;
+        }
     }
 
 public:
@@ -0,0 +1,201 @@
+#include "Tablebase.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include "ConnectFour.h"
+#include "MappedFile.h"
+
+namespace
+{
+	struct Header
+	{
+		char magic[4];
+		std::uint32_t version;
+		std::uint32_t maxEmpty;
+		std::uint32_t blockSize;
+		std::uint64_t entries;
+		std::uint64_t blocks;   // followed by the block index, then the block data
+		std::uint64_t dataSize;
+	};
+
+	const char kMagic[4] = { 'C', 'X', 'T', 'B' };
+	const std::uint32_t kVersion = 1;
+	const std::size_t kIndexEntryBytes = 2 * sizeof(std::uint64_t);
+
+	std::uint64_t readU64(const unsigned char* p)
+	{
+		std::uint64_t v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	void writeVarint(std::vector<unsigned char>& out, std::uint64_t v)
+	{
+		while (v >= 0x80)
+		{
+			out.push_back(static_cast<unsigned char>(v | 0x80));
+			v >>= 7;
+		}
+		out.push_back(static_cast<unsigned char>(v));
+	}
+
+	// Returns false if the varint runs past end
+	bool readVarint(const unsigned char*& p, const unsigned char* end, std::uint64_t& v)
+	{
+		v = 0;
+		for (int shift = 0; p < end && shift < 64; shift += 7)
+		{
+			const unsigned char byte = *p++;
+			v |= std::uint64_t(byte & 0x7F) << shift;
+			if (!(byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+}
+
+Tablebase::Tablebase() = default;
+Tablebase::~Tablebase() = default;
+
+bool Tablebase::open(const std::string& path)
+{
+	close();
+	auto file = std::make_unique<MappedFile>(path);
+	if (!file->data() || file->size() < sizeof(Header))
+		return false;
+
+	Header header;
+	std::memcpy(&header, file->data(), sizeof(header));
+	if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion || header.blockSize != kBlockSize)
+		return false;
+	const std::uint64_t available = file->size() - sizeof(Header);
+	if (header.entries == 0 || header.blocks != (header.entries + kBlockSize - 1) / kBlockSize
+		|| header.blocks > available / kIndexEntryBytes || header.dataSize != available - header.blocks * kIndexEntryBytes)
+		return false;
+
+	_index = file->data() + sizeof(Header);
+	_data = _index + header.blocks * kIndexEntryBytes;
+	_dataSize = static_cast<std::size_t>(header.dataSize);
+	_entries = header.entries;
+	_blocks = header.blocks;
+	_maxEmpty = static_cast<int>(header.maxEmpty);
+	_file = std::move(file);
+	return true;
+}
+
+void Tablebase::close()
+{
+	_file.reset();
+	_index = nullptr;
+	_data = nullptr;
+	_dataSize = 0;
+	_entries = 0;
+	_blocks = 0;
+	_maxEmpty = 0;
+}
+
+bool Tablebase::probe(std::uint64_t canonicalKey, int& value) const
+{
+	if (!_entries)
+		return false;
+	const int stones = ConnectFour::stonesOfKey(canonicalKey);
+	if (stones < 0 || ConnectFour::CELLS - stones > _maxEmpty)
+		return false;
+
+	// Last block whose first key is <= canonicalKey
+	std::uint64_t lo = 0;
+	std::uint64_t hi = _blocks;
+	while (hi - lo > 1)
+	{
+		const std::uint64_t mid = (lo + hi) / 2;
+		if (readU64(_index + mid * kIndexEntryBytes) <= canonicalKey)
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	std::uint64_t key = readU64(_index + lo * kIndexEntryBytes);
+	const std::uint64_t offset = readU64(_index + lo * kIndexEntryBytes + sizeof(std::uint64_t));
+	if (key > canonicalKey || offset >= _dataSize)
+		return false;
+
+	const unsigned char* p = _data + offset;
+	const unsigned char* end = _data + _dataSize;
+	const std::uint64_t count = std::min<std::uint64_t>(kBlockSize, _entries - lo * kBlockSize);
+	for (std::uint64_t i = 0; i < count; ++i)
+	{
+		if (i > 0)
+		{
+			std::uint64_t delta;
+			if (!readVarint(p, end, delta))
+				return false;
+			key += delta;
+		}
+		if (p >= end)
+			return false;
+		const std::int8_t v = static_cast<std::int8_t>(*p++);
+		if (key == canonicalKey)
+		{
+			value = v;
+			return true;
+		}
+		if (key > canonicalKey)
+			break;
+	}
+	return false;
+}
+
+bool Tablebase::write(const std::string& path, int maxEmpty, const std::vector<Entry>& entries)
+{
+	if (entries.empty())
+		return false;
+
+	std::vector<unsigned char> index;
+	std::vector<unsigned char> data;
+	for (std::size_t i = 0; i < entries.size(); ++i)
+	{
+		if (i % kBlockSize == 0)
+		{
+			const std::uint64_t first[2] = { entries[i].first, data.size() };
+			index.insert(index.end(), reinterpret_cast<const unsigned char*>(first), reinterpret_cast<const unsigned char*>(first) + sizeof(first));
+		}
+		else
+		{
+			writeVarint(data, entries[i].first - entries[i - 1].first);
+		}
+		data.push_back(static_cast<unsigned char>(entries[i].second));
+	}
+
+	Header header;
+	std::memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.version = kVersion;
+	header.maxEmpty = static_cast<std::uint32_t>(maxEmpty);
+	header.blockSize = kBlockSize;
+	header.entries = entries.size();
+	header.blocks = index.size() / kIndexEntryBytes;
+	header.dataSize = data.size();
+
+	// Write next to the target and swap it in, so a crash never leaves a torn table
+	const std::string tmpPath = path + ".tmp";
+	{
+		std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!out)
+			return false;
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		out.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size()));
+		out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		if (!out)
+			return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tmpPath, path, ec);
+	if (ec)
+	{
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
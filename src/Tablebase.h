@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class MappedFile;
+
+// Exact values of Connect 4 positions with few empty cells, generated offline by
+// connectxo-tablebase and memory-mapped read-only at runtime, so several AIPlayers can share
+// one instance. Entries are keyed by ConnectFour::getCanonicalKey(), sorted, and stored in blocks
+// of kBlockSize: the first key of every block in an index, the rest as varint key deltas, each
+// followed by its value byte.
+//
+// A value is from the side to move's point of view: +n wins in n plies, -n loses in n plies,
+// 0 is a draw.
+class Tablebase
+{
+public:
+    using Entry = std::pair<std::uint64_t, std::int8_t>; // canonical key, value
+
+    static constexpr std::uint32_t kBlockSize = 64;
+
+    Tablebase();
+    ~Tablebase();
+
+    // Maps the file; false (and closed) if it is missing or not a tablebase.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return _entries != 0; }
+
+    // Positions with more empty cells than this are never in the table.
+    int maxEmpty() const { return _maxEmpty; }
+    std::uint64_t size() const { return _entries; }
+
+    // Looks up a canonical Connect 4 key; misses for positions the table does not cover.
+    bool probe(std::uint64_t canonicalKey, int& value) const;
+
+    // Writes entries (sorted by key, no duplicates) to path via a temporary file.
+    static bool write(const std::string& path, int maxEmpty, const std::vector<Entry>& entries);
+
+private:
+    std::unique_ptr<MappedFile> _file;
+    const unsigned char* _index{ nullptr }; // blocks x (first key, data offset)
+    const unsigned char* _data{ nullptr };
+    std::size_t _dataSize{ 0 };
+    std::uint64_t _entries{ 0 };
+    std::uint64_t _blocks{ 0 };
+    int _maxEmpty{ 0 };
+};
@@ -10,12 +10,7 @@ public:
 
     std::unique_ptr<Game> clone() const override
     {
-        auto copy = std::make_unique<TicTacToe>();
-        copy->_board = _board;
-        copy->_currentPlayer = _currentPlayer;
-        copy->_winner = _winner;
-        copy->_gameOver = _gameOver;
-        return copy;
+        return std::make_unique<TicTacToe>(*this);
     }
 
     std::vector<Move> getValidMoves() const override
@@ -29,44 +24,113 @@ public:
         return validMoves;
     }
 
-    Player checkWin() const override
+    // Recorded by placeMove on the winning move
+    Player checkWin() const override { return _lineWinner; }
+
+    bool isDraw() const override
+    {
+        for (const auto& cell : _board)
+        {
+            if (cell == Player::None)
+                return false;
+        }
+        return true;
+    }
+
+    // Two bits per cell (X = 1, O = 2) plus the side to move; bit 63 keeps these keys apart
+    // from ConnectFour keys in a shared table.
+    std::uint64_t getKey() const override
+    {
+        return keyUnder(0);
+    }
+
+    // Smallest key over the 8 board symmetries (rotations and reflections).
+    std::uint64_t getCanonicalKey(int& symmetry) const override
     {
-        // Winning lines: 3 rows, 3 columns, 2 diagonals
-        const int winningLines[8][3] = {
-            // Rows
-            {0, 1, 2},
-            {3, 4, 5},
-            {6, 7, 8},
-            // Columns
-            {0, 3, 6},
-            {1, 4, 7},
-            {2, 5, 8},
-            // Diagonals
-            {0, 4, 8},
-            {2, 4, 6}
-        };
-
-        for (const auto& line : winningLines)
+        symmetry = 0;
+        std::uint64_t best = keyUnder(0);
+        for (int s = 1; s < 8; ++s)
         {
-            if (_board[line[0]] != Player::None &&
-                _board[line[0]] == _board[line[1]] &&
-                _board[line[1]] == _board[line[2]])
+            const std::uint64_t key = keyUnder(s);
+            if (key < best)
             {
-                return _board[line[0]];
+                best = key;
+                symmetry = s;
             }
         }
+        return best;
+    }
+
+    bool isWinningMove(Player player, Move move) const override
+    {
+        if (move < 0 || move > 8 || _board[move] != Player::None)
+            return false;
 
-        return Player::None;
+        for (const auto& line : kWinningLines)
+        {
+            int own = 0;
+            bool throughMove = false;
+            for (int cell : line)
+            {
+                if (cell == move)
+                    throughMove = true;
+                else if (_board[cell] == player)
+                    ++own;
+            }
+            if (throughMove && own == 2)
+                return true;
+        }
+        return false;
     }
 
-    bool isDraw() const override
+    // Random game to the end on two 9-bit masks instead of cloned boards.
+    Player randomPlayout(std::mt19937& rng) const override
     {
-        for (const auto& cell : _board)
+        if (_gameOver)
+            return _winner;
+
+        unsigned stones[2] = { 0, 0 }; // [0] = player to move
+        for (int i = 0; i < 9; ++i)
         {
-            if (cell == Player::None)
-                return false;
+            if (_board[i] != Player::None)
+                stones[_board[i] == _currentPlayer ? 0 : 1] |= 1u << i;
         }
-        return true;
+
+        const Player other = (_currentPlayer == Player::X) ? Player::O : Player::X;
+        for (int side = 0;; side ^= 1)
+        {
+            const unsigned empty = ~(stones[0] | stones[1]) & 0x1FFu;
+            if (empty == 0)
+                return Player::None;
+            int cells[9];
+            int count = 0;
+            for (int i = 0; i < 9; ++i)
+            {
+                if (empty & (1u << i))
+                    cells[count++] = i;
+            }
+            stones[side] |= 1u << cells[rng() % count];
+            for (unsigned mask : kWinningMasks)
+            {
+                if ((stones[side] & mask) == mask)
+                    return side == 0 ? _currentPlayer : other;
+            }
+        }
+    }
+
+    Move toCanonicalMove(Move move, int symmetry) const override
+    {
+        for (int cell = 0; cell < 9; ++cell)
+        {
+            if (kSymmetries[symmetry][cell] == move)
+                return cell;
+        }
+        return move;
+    }
+
+    Move fromCanonicalMove(Move move, int symmetry) const override
+    {
+        return (move >= 0 && move < 9) ? kSymmetries[symmetry][move] : move;
     }
 
     // Getter for board cell at index (for UI rendering)
@@ -77,6 +141,15 @@ public:
         return _board[index];
     }
 
+    // Cells of the completed line as a mask (bit i = cell i), 0 while nobody has won
+    unsigned winningLine() const { return _winningLine; }
+
+    // Empty cells where player would complete a line, as a mask; kept up to date move by move
+    unsigned threatCells(Player player) const
+    {
+        return player == Player::None ? 0u : _threats[player == Player::X ? 0 : 1];
+    }
+
 protected:
     bool placeMove(Player player, Move move) override
     {
@@ -87,14 +160,88 @@ protected:
             return false;
 
         _board[move] = player;
+        const int side = (player == Player::X) ? 0 : 1;
+        _stones[side] |= 1u << move;
+
+        const unsigned empty = ~(_stones[0] | _stones[1]) & 0x1FFu;
+        _threats[0] = _threats[1] = 0;
+        for (unsigned mask : kWinningMasks)
+        {
+            if (_lineWinner == Player::None && (_stones[side] & mask) == mask)
+            {
+                _lineWinner = player;
+                _winningLine = mask;
+            }
+            // Two stones of one player and an empty third cell
+            for (int s = 0; s < 2; ++s)
+            {
+                const unsigned rest = mask & ~_stones[s];
+                if ((rest & empty) == rest && (rest & (rest - 1)) == 0)
+                    _threats[s] |= rest;
+            }
+        }
         return true;
     }
 
     void clearBoard() override
     {
         _board.fill(Player::None);
+        _stones[0] = _stones[1] = 0;
+        _threats[0] = _threats[1] = 0;
+        _winningLine = 0;
+        _lineWinner = Player::None;
     }
 
 private:
+    // Winning lines: 3 rows, 3 columns, 2 diagonals
+    static constexpr int kWinningLines[8][3] = {
+        // Rows
+        {0, 1, 2},
+        {3, 4, 5},
+        {6, 7, 8},
+        // Columns
+        {0, 3, 6},
+        {1, 4, 7},
+        {2, 5, 8},
+        // Diagonals
+        {0, 4, 8},
+        {2, 4, 6}
+    };
+
+    // kWinningLines as cell bit masks
+    static constexpr unsigned kWinningMasks[8] = {
+        0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054
+    };
+
+    // Cell i of the transformed board is cell kSymmetries[s][i] of this one
+    static constexpr int kSymmetries[8][9] = {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8}, // identity
+        {6, 3, 0, 7, 4, 1, 8, 5, 2}, // rotate 90
+        {8, 7, 6, 5, 4, 3, 2, 1, 0}, // rotate 180
+        {2, 5, 8, 1, 4, 7, 0, 3, 6}, // rotate 270
+        {2, 1, 0, 5, 4, 3, 8, 7, 6}, // mirror left/right
+        {6, 7, 8, 3, 4, 5, 0, 1, 2}, // mirror top/bottom
+        {0, 3, 6, 1, 4, 7, 2, 5, 8}, // main diagonal
+        {8, 5, 2, 7, 4, 1, 6, 3, 0}  // anti-diagonal
+    };
+
+    std::uint64_t keyUnder(int symmetry) const
+    {
+        std::uint64_t key = 0;
+        for (int i = 0; i < 9; ++i)
+        {
+            const Player p = _board[kSymmetries[symmetry][i]];
+            const std::uint64_t cell = (p == Player::X) ? 1 : (p == Player::O) ? 2 : 0;
+            key |= cell << (2 * i);
+        }
+        if (_currentPlayer == Player::O)
+            key |= std::uint64_t(1) << 18;
+        return key | (std::uint64_t(1) << 63);
+    }
+
     std::array<Player, 9> _board;
+    unsigned _stones[2]{ 0, 0 };  // X, O cell masks
+    unsigned _threats[2]{ 0, 0 };
+    unsigned _winningLine{ 0 };
+    Player _lineWinner{ Player::None };
 };
@@ -41,7 +41,8 @@ public:
     TicTacToeView()
         : Canvas({ gui::InputDevice::Event::PrimaryClicks, gui::InputDevice::Event::CursorMove })
         , _game()
-        , _aiPlayer()
+        , _aiPlayer(1) // a 1 MB table holds every Tic-Tac-Toe position
+        , _hintPlayer(1)
         , _imgX()
         , _imgO()
         , _clickSound(":click")
@@ -167,31 +168,19 @@ protected:
         }
     }
 
-    // Helper: Find which cells form the winning line
-    std::vector<int> getWinningLine()
+    // Helper: first and last cell of a winning line mask (recorded by the game on the winning move)
+    static void lineEnds(unsigned line, int& first, int& last)
     {
-        const int winningLines[8][3] = {
-            // Rows
-            {0,1,2}, {3,4,5}, {6,7,8},
-            // Columns
-            {0,3,6}, {1,4,7}, {2,5,8},
-            // Diagonals
-            {0,4,8}, {2,4,6}
-        };
-
-        Player winner = _game.getWinner();
-        if (winner == Player::None) return {};
-
-        for (const auto& line : winningLines)
+        first = last = -1;
+        for (int i = 0; i < 9; ++i)
         {
-            if (_game.getCell(line[0]) == winner &&
-                _game.getCell(line[1]) == winner &&
-                _game.getCell(line[2]) == winner)
+            if (line & (1u << i))
             {
-                return { line[0], line[1], line[2] };
+                if (first < 0)
+                    first = i;
+                last = i;
             }
         }
-        return {};
     }
 
     void onDraw(const gui::Rect& rect) override
@@ -377,9 +366,9 @@ protected:
         }
 
         // Draw pieces inside board
-        std::vector<int> winningLine = _game.isGameOver() ? getWinningLine() : std::vector<int>();
+        const unsigned winningLine = _game.winningLine();
         float pulseScale = 1.0f;
-        if (!winningLine.empty())
+        if (winningLine != 0)
         {
             // Calculate win pulse animation
             auto now = std::chrono::steady_clock::now();
@@ -402,7 +391,7 @@ protected:
 
                 // Apply pulse scale if part of winning line
                 float scale = 1.0f;
-                if (!winningLine.empty() && std::find(winningLine.begin(), winningLine.end(), idx) != winningLine.end())
+                if (winningLine & (1u << idx))
                 {
                     scale = pulseScale;
                     pieceSize *= scale;
@@ -607,8 +596,7 @@ protected:
         if (_game.isGameOver())
         {
             // Highlight winning line by drawing a single thick line between the centers of the first and last cells
-            auto winningLine = getWinningLine();
-            if (winningLine.size() == 3)
+            if (winningLine != 0)
             {
                 const double cellSz = _cellSize;
                 const float winStroke = std::max(3.0f, static_cast<float>(cellSz * 0.15));
@@ -620,8 +608,8 @@ protected:
                     lineColor = loseLine;
 
 
-                int idx0 = winningLine.front();
-                int idx2 = winningLine.back();
+                int idx0, idx2;
+                lineEnds(winningLine, idx0, idx2);
                 int row0 = idx0 / 3; int col0 = idx0 % 3;
                 int row2 = idx2 / 3; int col2 = idx2 % 3;
 
@@ -745,9 +733,10 @@ protected:
             {
                 _aiMoveScheduled = true;
                 int gen = ++_aiGen;
-                std::thread aiStartThread([this, gen]() {
+                const EngineConfig config = EngineConfig::forCurrentDifficulty(12); // snapshot on the UI thread
+                std::thread aiStartThread([this, gen, config]() {
                     std::this_thread::sleep_for(std::chrono::milliseconds(500));
-                    Game::Move aiMove = _aiPlayer.chooseMove(_game, 12);
+                    Game::Move aiMove = _aiPlayer.chooseMove(_game, config);
                     auto* fn = new gui::AsyncFn([this, aiMove, gen]() {
                         if (gen == _aiGen)
                         {
@@ -842,9 +831,10 @@ private:
     {
         _aiMoveScheduled = true;
         int gen = ++_aiGen;
-        std::thread aiThread([this, gen]() {
+        const EngineConfig config = EngineConfig::forCurrentDifficulty(10); // snapshot on the UI thread
+        std::thread aiThread([this, gen, config]() {
             std::this_thread::sleep_for(std::chrono::milliseconds(400));
-            Game::Move aiMove = _aiPlayer.chooseMove(_game, 10);
+            Game::Move aiMove = _aiPlayer.chooseMove(_game, config);
             auto* fn = new gui::AsyncFn([this, aiMove, gen]() {
                 if (gen != _aiGen)
                 {
@@ -889,14 +879,16 @@ private:
             return -1;
 
         // Use AI engine to evaluate - it will find the best move
-        // using minimax with alpha-beta pruning at depth 8
-        return _aiPlayer.chooseMove(_game, 8);
+        // using minimax with alpha-beta pruning at depth 8, always at full strength
+        // (the hint is not weakened by the opponent's difficulty setting)
+        return _hintPlayer.chooseMove(_game, EngineConfig::fullStrength(8));
     }
 
 
 private:
     TicTacToe _game;
     AIPlayer _aiPlayer;
+    AIPlayer _hintPlayer; // separate engine so a hint never shares state with the AI's search
     gui::Image _imgX;
     gui::Image _imgO;
     gui::Image _imgWood;
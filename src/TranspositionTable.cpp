@@ -0,0 +1,261 @@
+#include "TranspositionTable.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <vector>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+	// data layout: score (16) | depth (8) | bound (8) | generation (8) | unused (8) | move + 1 (16).
+	// 16 move bits cover every cell index of the largest m,n,k board (19x19 = 361 cells).
+	std::uint64_t pack(int score, int depth, TranspositionTable::Bound bound, int move, std::uint8_t generation)
+	{
+		return std::uint64_t(std::uint16_t(std::int16_t(score)))
+			| (std::uint64_t(std::uint8_t(depth)) << 16)
+			| (std::uint64_t(bound) << 24)
+			| (std::uint64_t(generation) << 32)
+			| (std::uint64_t(std::uint16_t(move + 1)) << 48);
+	}
+
+	int scoreOf(std::uint64_t data) { return std::int16_t(std::uint16_t(data & 0xFFFF)); }
+	int depthOf(std::uint64_t data) { return int((data >> 16) & 0xFF); }
+	TranspositionTable::Bound boundOf(std::uint64_t data) { return TranspositionTable::Bound((data >> 24) & 0xFF); }
+	int moveOf(std::uint64_t data) { return int((data >> 48) & 0xFFFF) - 1; }
+	std::uint8_t generationOf(std::uint64_t data) { return std::uint8_t((data >> 32) & 0xFF); }
+
+	// Higher = more worth keeping: results of the current search first, then by depth
+	int keepRank(std::uint64_t data, std::uint8_t generation)
+	{
+		if (boundOf(data) == TranspositionTable::Bound::None)
+			return -1;
+		return (generationOf(data) == generation ? 256 : 0) + depthOf(data);
+	}
+
+	const std::size_t kHugePageSize = std::size_t(2) << 20;
+
+	void* alignedAlloc(std::size_t alignment, std::size_t bytes)
+	{
+#if defined(_WIN32)
+		return _aligned_malloc(bytes, alignment);
+#else
+		void* p = nullptr;
+		return (posix_memalign(&p, alignment, bytes) == 0) ? p : nullptr;
+#endif
+	}
+
+	void alignedFree(void* p)
+	{
+#if defined(_WIN32)
+		_aligned_free(p);
+#else
+		std::free(p);
+#endif
+	}
+
+	struct SnapshotHeader
+	{
+		char magic[4];
+		std::uint32_t version;
+		std::uint64_t count; // followed by count (key, data) pairs
+	};
+
+	const char kSnapshotMagic[4] = { 'C', 'X', 'T', 'T' };
+	const std::uint32_t kSnapshotVersion = 2; // 2: 16-bit move field
+}
+
+TranspositionTable::TranspositionTable(std::size_t megabytes, bool hugePages)
+{
+	resize(megabytes, hugePages);
+}
+
+TranspositionTable::~TranspositionTable()
+{
+	release();
+}
+
+void TranspositionTable::release()
+{
+	if (_buckets)
+		alignedFree(_buckets);
+	_buckets = nullptr;
+	_mask = 0;
+}
+
+void TranspositionTable::resize(std::size_t megabytes, bool hugePages)
+{
+	release();
+
+	// Largest power-of-two bucket count that fits the budget
+	const std::size_t budget = std::max<std::size_t>(1, megabytes) << 20;
+	std::size_t count = 1;
+	while (count * 2 * sizeof(Bucket) <= budget)
+		count <<= 1;
+	const std::size_t bytes = count * sizeof(Bucket);
+
+	// Huge pages need the table aligned to the huge page size to be of any use
+	const std::size_t alignment = (hugePages && bytes >= kHugePageSize) ? kHugePageSize : alignof(Bucket);
+	void* memory = alignedAlloc(alignment, bytes);
+	if (!memory)
+		throw std::bad_alloc();
+#if defined(MADV_HUGEPAGE)
+	if (hugePages)
+		::madvise(memory, bytes, MADV_HUGEPAGE); // advisory; ignored where THP is disabled
+#endif
+
+	_buckets = static_cast<Bucket*>(memory);
+	for (std::size_t i = 0; i < count; ++i)
+		new (&_buckets[i]) Bucket();
+	_mask = count - 1;
+}
+
+void TranspositionTable::newSearch()
+{
+	_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear()
+{
+	for (std::size_t i = 0; i <= _mask; ++i)
+	{
+		for (Slot& slot : _buckets[i].slots)
+		{
+			slot.check.store(0, std::memory_order_relaxed);
+			slot.data.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+bool TranspositionTable::probe(std::uint64_t key, Entry& entry) const
+{
+	for (const Slot& slot : bucketOf(key).slots)
+	{
+		const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+		const std::uint64_t check = slot.check.load(std::memory_order_relaxed);
+		if ((check ^ data) != key || boundOf(data) == Bound::None)
+			continue;
+
+		entry.score = scoreOf(data);
+		entry.depth = depthOf(data);
+		entry.bound = boundOf(data);
+		entry.move = moveOf(data);
+		return true;
+	}
+	return false;
+}
+
+void TranspositionTable::store(std::uint64_t key, int score, int depth, Bound bound, int move)
+{
+	Bucket& bucket = bucketOf(key);
+	const std::uint8_t generation = _generation.load(std::memory_order_relaxed);
+
+	// Picks the slot in [first, last) already holding the key, else the one least worth keeping
+	auto pickVictim = [&](int first, int last) {
+		Slot* victim = nullptr;
+		int victimRank = std::numeric_limits<int>::max();
+		for (int i = first; i < last; ++i)
+		{
+			Slot& slot = bucket.slots[i];
+			const std::uint64_t old = slot.data.load(std::memory_order_relaxed);
+			if ((slot.check.load(std::memory_order_relaxed) ^ old) == key)
+				return &slot;
+			const int rank = keepRank(old, generation);
+			if (rank < victimRank)
+			{
+				victimRank = rank;
+				victim = &slot;
+			}
+		}
+		return victim;
+	};
+
+	// A depth-preferred slot only gives way to a result at least as deep, unless it is stale
+	Slot* target = pickVictim(0, kDepthSlots);
+	const std::uint64_t old = target->data.load(std::memory_order_relaxed);
+	if (boundOf(old) != Bound::None && generationOf(old) == generation && depthOf(old) > depth)
+		target = pickVictim(kDepthSlots, kSlotsPerBucket);
+
+	const std::uint64_t data = pack(score, depth, bound, move, generation);
+	target->data.store(data, std::memory_order_relaxed);
+	target->check.store(key ^ data, std::memory_order_relaxed);
+}
+
+bool TranspositionTable::save(const std::string& path) const
+{
+	std::vector<std::uint64_t> records;
+	for (std::size_t i = 0; i <= _mask; ++i)
+	{
+		for (const Slot& slot : _buckets[i].slots)
+		{
+			const std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+			const std::uint64_t check = slot.check.load(std::memory_order_relaxed);
+			if (boundOf(data) == Bound::None)
+				continue;
+			records.push_back(check ^ data);
+			records.push_back(data);
+		}
+	}
+
+	// Write next to the target and swap it in, so a crash never leaves a torn snapshot
+	const std::string tmpPath = path + ".tmp";
+	{
+		std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!out)
+			return false;
+
+		SnapshotHeader header;
+		std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+		header.version = kSnapshotVersion;
+		header.count = records.size() / 2;
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(std::uint64_t)));
+		if (!out)
+			return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tmpPath, path, ec);
+	if (ec)
+	{
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool TranspositionTable::load(const std::string& path)
+{
+	MappedFile file(path);
+	if (!file.data() || file.size() < sizeof(SnapshotHeader))
+		return false;
+
+	SnapshotHeader header;
+	std::memcpy(&header, file.data(), sizeof(header));
+	if (std::memcmp(header.magic, kSnapshotMagic, sizeof(header.magic)) != 0 || header.version != kSnapshotVersion)
+		return false;
+	if (header.count > (file.size() - sizeof(header)) / (2 * sizeof(std::uint64_t)))
+		return false;
+
+	const unsigned char* records = file.data() + sizeof(header);
+	for (std::uint64_t i = 0; i < header.count; ++i)
+	{
+		std::uint64_t record[2];
+		std::memcpy(record, records + i * sizeof(record), sizeof(record));
+		const std::uint64_t data = record[1];
+		if (boundOf(data) == Bound::None || boundOf(data) > Bound::Upper)
+			continue;
+		store(record[0], scoreOf(data), depthOf(data), boundOf(data), moveOf(data)); // as current-generation results
+	}
+	return true;
+}
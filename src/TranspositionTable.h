@@ -0,0 +1,110 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+// Transposition table shared by every search of one AIPlayer. Entries outlive a single search;
+// each search bumps a generation counter and entries from older generations are the first to be
+// overwritten, so nothing ever needs clearing between moves or games.
+// Memory is a power-of-two array of 64-byte (one cache line) buckets holding four 16-byte slots:
+// two depth-preferred slots that only give way to deeper or older results and two always-replace
+// slots that take everything else. A slot is two relaxed atomics (key ^ data, data), so concurrent
+// root workers can read and write without locks; a torn slot simply fails the key check.
+class TranspositionTable
+{
+public:
+    enum class Bound : std::uint8_t
+    {
+        None,
+        Exact,
+        Lower, // score is at least this (fail high)
+        Upper  // score is at most this (fail low)
+    };
+
+    struct Entry
+    {
+        int score{ 0 };  // side-to-move point of view, as stored by the search
+        int depth{ 0 };  // remaining depth the score was searched to
+        Bound bound{ Bound::None };
+        int move{ -1 };  // best or refuting move, -1 if unknown
+    };
+
+    static constexpr std::size_t kDefaultMegabytes = 4;
+
+    // hugePages asks the OS to back the table with huge pages where supported (Linux
+    // madvise(MADV_HUGEPAGE)); fewer TLB misses on large tables.
+    explicit TranspositionTable(std::size_t megabytes = kDefaultMegabytes, bool hugePages = false);
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    // Reallocates (and empties) the table; must not race with a search.
+    void resize(std::size_t megabytes, bool hugePages = false);
+
+    // Starts a new search generation; older entries become preferred victims.
+    void newSearch();
+    void clear();
+
+    bool probe(std::uint64_t key, Entry& entry) const;
+    void store(std::uint64_t key, int score, int depth, Bound bound, int move);
+
+    // Hints the CPU to start loading the key's bucket, e.g. before recursing into a child.
+    void prefetch(std::uint64_t key) const
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(reinterpret_cast<const char*>(&bucketOf(key)), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(&bucketOf(key));
+#endif
+    }
+
+    std::size_t capacity() const { return (_mask + 1) * kSlotsPerBucket; }
+    std::size_t megabytes() const { return ((_mask + 1) * sizeof(Bucket)) >> 20; }
+
+    // Snapshot of the live entries. load() maps the file read-only and re-inserts its entries as
+    // current-generation results; both return false if the file cannot be used.
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> check{ 0 }; // key ^ data
+        std::atomic<std::uint64_t> data{ 0 };  // score, depth, bound, generation, move
+    };
+
+    static constexpr int kSlotsPerBucket = 4;
+    static constexpr int kDepthSlots = 2; // slots [0, kDepthSlots) are depth-preferred
+
+    struct alignas(64) Bucket
+    {
+        Slot slots[kSlotsPerBucket];
+    };
+    static_assert(sizeof(Slot) == 16, "slot must stay 16 bytes");
+    static_assert(sizeof(Bucket) == 64, "bucket must fill exactly one cache line");
+
+    const Bucket& bucketOf(std::uint64_t key) const
+    {
+        // splitmix64 finalizer: packed board keys are far from uniform in their low bits
+        key ^= key >> 30;
+        key *= 0xBF58476D1CE4E5B9ULL;
+        key ^= key >> 27;
+        key *= 0x94D049BB133111EBULL;
+        key ^= key >> 31;
+        return _buckets[static_cast<std::size_t>(key) & _mask];
+    }
+    Bucket& bucketOf(std::uint64_t key)
+    {
+        return const_cast<Bucket&>(static_cast<const TranspositionTable*>(this)->bucketOf(key));
+    }
+    void release();
+
+    Bucket* _buckets{ nullptr };
+    std::size_t _mask{ 0 };
+    std::atomic<std::uint8_t> _generation{ 0 };
+};
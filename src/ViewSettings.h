@@ -12,6 +12,7 @@
 #include <vector>
 #include "Theme.h"
 #include "ScoreManager.h"
+#include "ConnectFour.h"
 
 // Functions provided by AIPlayer module to change/get difficulty at runtime
 extern "C" void setAIDifficultyIndex(int idx);
@@ -31,9 +32,13 @@ protected:
     gui::ComboBox _cmbHint;
     gui::Label _lblTheme;
     gui::ComboBox _cmbThemes;
+    gui::Label _lblC4Board;
+    gui::ComboBox _cmbC4Board;
     gui::Label _lblResetScores;
     gui::Button _btnResetTTT;
     gui::Button _btnResetC4;
+    gui::Button _btnResetMNK;
+    gui::Button _btnResetQubic;
     gui::GridLayout _gl;
     gui::Label _lblRestartInfo;
     int _initialLangSelection;
@@ -128,10 +133,13 @@ public:
         , _lblAIDifficultyValue("")
         , _lblHintDisplay(tr("lblHintDisplay"))
         , _lblTheme(tr("themesList"))
+        , _lblC4Board(tr("lblC4Board"))
         , _lblResetScores(tr("resetScoresLbl"))
         , _btnResetTTT(tr("resetTTTLbl"))
         , _btnResetC4(tr("resetC4Lbl"))
-        , _gl(9, 2) // Increased rows to accommodate reset buttons
+        , _btnResetMNK(tr("resetMNKLbl"))
+        , _btnResetQubic(tr("resetQubicLbl"))
+        , _gl(11, 2) // Increased rows to accommodate reset buttons and the board size
         , _lblRestartInfo(tr("RestartRequiredInfo"))
         , _baseRestartText(tr("RestartRequiredInfo"))
     {
@@ -219,11 +227,12 @@ public:
         _initialAIDifficulty = aiIdx;
         updateDifficultyLabel(); // Set initial label text (now composes into the main label)
 
-        // Hint display combo: On/Off
+        // Hint display combo: On/Off/On with the Connect 4 column evaluation ("showHint" 1/0/2)
         _cmbHint.addItem(tr("hintOn"));
         _cmbHint.addItem(tr("hintOff"));
+        _cmbHint.addItem(tr("hintOnEval"));
         int hintSetting = appProperties->getValue("showHint", 1);
-        _cmbHint.selectIndex(hintSetting ? 0 : 1);
+        _cmbHint.selectIndex(hintSetting == 2 ? 2 : (hintSetting ? 0 : 1));
 
         // Theme combo: Classic, Nature, Strawberry, Beachy, Dark
         _cmbThemes.addItem(tr("themeClassic"));
@@ -239,6 +248,14 @@ public:
         _cmbThemes.selectIndex(themeIdx);
         _initialThemeSelection = themeIdx;
 
+        // Connect 4 board size, in ConnectVariant order; the view picks it up when the next game starts
+        _cmbC4Board.addItem(tr("c4BoardClassic"));
+        _cmbC4Board.addItem("8 x 7");
+        _cmbC4Board.addItem("9 x 7");
+        _cmbC4Board.addItem("10 x 8");
+        _cmbC4Board.addItem(tr("c4BoardConnect5"));
+        _cmbC4Board.selectIndex(static_cast<int>(clampConnectVariant(appProperties->getValue("c4Board", 0))));
+
         // event handlers
         _cmbLangs.onChangedSelection([this, appProperties]() {
             if (_suppressChangeEvents) return;
@@ -280,10 +297,18 @@ public:
         _cmbHint.onChangedSelection([this, appProperties]() {
             int sel = this->_cmbHint.getSelectedIndex();
             if (sel < 0) sel = 0;
-            if (sel > 1) sel = 1;
+            if (sel > 2) sel = 2;
+            if (appProperties)
+            {
+                appProperties->setValue("showHint", sel == 0 ? 1 : (sel == 2 ? 2 : 0));
+            }
+            });
+
+        _cmbC4Board.onChangedSelection([this, appProperties]() {
+            int sel = static_cast<int>(clampConnectVariant(this->_cmbC4Board.getSelectedIndex()));
             if (appProperties)
             {
-                appProperties->setValue("showHint", sel == 0 ? 1 : 0);
+                appProperties->setValue("c4Board", sel);
             }
             });
 
@@ -327,8 +352,10 @@ public:
         // but it is not added as a separate row anymore.
         gc.appendRow(_lblHintDisplay) << _cmbHint;
         gc.appendRow(_lblTheme) << _cmbThemes;
+        gc.appendRow(_lblC4Board) << _cmbC4Board;
         gc.appendRow(_lblResetScores, 2); // Span for section header
         gc.appendRow(_btnResetTTT) << _btnResetC4;
+        gc.appendRow(_btnResetMNK) << _btnResetQubic;
         gc.appendRow(_lblRestartInfo, 2); // Span across both columns for the restart info
 
         setLayout(&_gl);
@@ -359,6 +386,16 @@ public:
             ScoreManager::getInstance().resetC4Stats();
             return true;
         }
+        if (pBtn == &_btnResetMNK)
+        {
+            ScoreManager::getInstance().resetMNKStats();
+            return true;
+        }
+        if (pBtn == &_btnResetQubic)
+        {
+            ScoreManager::getInstance().resetQubicStats();
+            return true;
+        }
         return false;
     }
 
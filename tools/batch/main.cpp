@@ -0,0 +1,183 @@
+// connectxo-batch: streaming Connect Four position analyzer.
+//
+//   connectxo-batch [--input FILE] [--output FILE] [--depth N]
+//                   [--threads N] [--window N] [--offset N]
+//
+// Input (stdin by default): one position per line, either a move string ("3324", "-" for the
+// empty board) or a packed key from ConnectFour::getKey() written as hex ("0x...").
+// Output (stdout by default), one line per input line and in input order:
+//   key,score,bestMove,nodes
+// key is the packed key in hex, score is from the side to move (|score| >= 1000 is a forced
+// result). Invalid lines produce "<input>,error,-1,0"; finished games report bestMove -1.
+//
+// Lines are read in windows of --window positions which are evaluated on the thread pool and
+// written before the next window is read, so memory stays bounded for any input size.
+// To resume an interrupted run, pass --offset with the number of lines already written;
+// the input lines before it are skipped and --output is appended to.
+//
+// The search is AIPlayer::search: the engine the views use, at full strength and a fixed depth
+// (default 10, the Connect 4 view's AI move) so results do not depend on machine speed.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AIPlayer.h"
+#include "ConnectFour.h"
+#include "PositionText.h"
+
+namespace
+{
+	struct Options
+	{
+		std::string inputPath;
+		std::string outputPath;
+		int depth = 10;
+		int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+		size_t window = 0;
+		unsigned long long offset = 0;
+	};
+
+	struct Job
+	{
+		std::string input;
+		std::string output;
+	};
+
+	bool parsePosition(const std::string& text, ConnectFour& game)
+	{
+		game.reset(Player::X);
+		if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+		{
+			char* end = nullptr;
+			const unsigned long long key = std::strtoull(text.c_str() + 2, &end, 16);
+			return end && *end == '\0' && game.setFromKey(key);
+		}
+		return applyMoves(game, text);
+	}
+
+	// ai is the calling worker's engine; search() clears its table, so reuse does not change results
+	std::string analyze(AIPlayer& ai, const std::string& text, int depth)
+	{
+		ConnectFour game;
+		if (text.empty() || !parsePosition(text, game))
+			return text + ",error,-1,0";
+
+		char key[32];
+		std::snprintf(key, sizeof(key), "0x%llx", static_cast<unsigned long long>(game.getKey()));
+
+		if (game.isGameOver())
+		{
+			// The player who made the last move won; report it from the (next) side to move.
+			const int score = game.getWinner() == Player::None ? 0 : -1000;
+			return std::string(key) + "," + std::to_string(score) + ",-1,0";
+		}
+
+		const SearchResult r = ai.search(game, depth);
+		return std::string(key) + "," + std::to_string(r.score) + "," + std::to_string(r.move) + "," + std::to_string(r.nodes);
+	}
+
+	// players holds one engine per worker, kept across windows so their tables are allocated once
+	void processWindow(std::vector<Job>& jobs, std::vector<std::unique_ptr<AIPlayer>>& players, int depth)
+	{
+		std::atomic<size_t> next{ 0 };
+		std::vector<std::thread> workers;
+		const int count = std::min<int>(static_cast<int>(players.size()), static_cast<int>(jobs.size()));
+		for (int t = 0; t < count; ++t)
+		{
+			workers.emplace_back([&, t]() {
+				for (size_t i = next++; i < jobs.size(); i = next++)
+					jobs[i].output = analyze(*players[t], jobs[i].input, depth);
+				});
+		}
+		for (auto& w : workers)
+			w.join();
+	}
+}
+
+int main(int argc, const char* argv[])
+{
+	Options opt;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		auto next = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+		if (arg == "--input") opt.inputPath = next();
+		else if (arg == "--output") opt.outputPath = next();
+		else if (arg == "--depth") opt.depth = std::max(1, std::atoi(next().c_str()));
+		else if (arg == "--threads") opt.threads = std::max(1, std::atoi(next().c_str()));
+		else if (arg == "--window") opt.window = static_cast<size_t>(std::max(1, std::atoi(next().c_str())));
+		else if (arg == "--offset") opt.offset = std::strtoull(next().c_str(), nullptr, 10);
+		else
+		{
+			std::cerr << "usage: connectxo-batch [--input FILE] [--output FILE] [--depth N] [--threads N] [--window N] [--offset N]\n";
+			return 2;
+		}
+	}
+	if (opt.window == 0)
+		opt.window = static_cast<size_t>(opt.threads) * 64;
+
+	std::ifstream inFile;
+	if (!opt.inputPath.empty())
+	{
+		inFile.open(opt.inputPath);
+		if (!inFile)
+		{
+			std::cerr << "cannot read " << opt.inputPath << "\n";
+			return 2;
+		}
+	}
+	std::istream& in = opt.inputPath.empty() ? std::cin : inFile;
+
+	std::ofstream outFile;
+	if (!opt.outputPath.empty())
+	{
+		outFile.open(opt.outputPath, opt.offset > 0 ? std::ios::app : std::ios::trunc);
+		if (!outFile)
+		{
+			std::cerr << "cannot write " << opt.outputPath << "\n";
+			return 2;
+		}
+	}
+	std::ostream& out = opt.outputPath.empty() ? std::cout : outFile;
+
+	std::string line;
+	unsigned long long lineNo = 0;
+	while (lineNo < opt.offset && std::getline(in, line))
+		++lineNo;
+
+	std::vector<std::unique_ptr<AIPlayer>> players;
+	for (int t = 0; t < opt.threads; ++t)
+		players.push_back(std::make_unique<AIPlayer>());
+
+	std::vector<Job> jobs;
+	jobs.reserve(opt.window);
+	bool more = true;
+	while (more)
+	{
+		jobs.clear();
+		while (jobs.size() < opt.window && (more = static_cast<bool>(std::getline(in, line))))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			jobs.push_back({ line, std::string() });
+		}
+		if (jobs.empty())
+			break;
+
+		processWindow(jobs, players, opt.depth);
+		for (const auto& job : jobs)
+			out << job.output << '\n';
+		out.flush();
+
+		lineNo += jobs.size();
+		std::cerr << "processed " << lineNo << " lines\n";
+	}
+	return 0;
+}
@@ -0,0 +1,343 @@
+// Headless engine benchmark: runs AIPlayer::search over a fixed position corpus
+// at several depths and thread counts and reports latency / node throughput.
+//
+//   connectxo-bench [--corpus FILE] [--depths 6,8,10] [--threads 1,2,4]
+//                   [--iterations N] [--filter TEXT] [--json FILE] [--hash MB [--huge-pages]]
+//                   [--baseline FILE [--max-regression PCT] [--min-delta-ms MS]]
+//   connectxo-bench --mcts PLAYOUTS [--threads 1,2,4,8] [--root-parallel] [--iterations N] [--filter TEXT]
+//
+// With --baseline the run is compared against a previous --json output: a position whose
+// chosen move, score or node count changed is reported and the process exits with status 1.
+// These are deterministic for a fixed depth, so the check holds on any machine. Latency is only
+// compared when --max-regression is given: then a median that grew by more than PCT percent (and
+// at least MS milliseconds) fails too, which only makes sense against a baseline from the same
+// machine and build type.
+//
+// "threads" is the number of search threads (root moves split across them).
+//
+// --mcts runs the Monte Carlo search on the Connect Four positions instead, with a fixed number
+// of playouts per move, and reports playouts/sec per thread count (tree-parallel by default).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "AIPlayer.h"
+#include "PositionText.h"
+#include "BenchReport.h"
+
+#ifndef CONNECTXO_BENCH_CORPUS
+#define CONNECTXO_BENCH_CORPUS "positions.txt"
+#endif
+
+namespace
+{
+	struct CorpusEntry
+	{
+		std::string name;
+		std::string game;
+		std::string phase;
+		std::string moves;
+	};
+
+	struct Options
+	{
+		std::string corpus = CONNECTXO_BENCH_CORPUS;
+		std::vector<int> depths{ 6, 8, 10 };
+		std::vector<int> threads{ 1, 2 };
+		int iterations = 5;
+		int hashMb = static_cast<int>(TranspositionTable::kDefaultMegabytes);
+		bool hugePages = false;
+		std::string filter;
+		std::string jsonPath;
+		std::string baselinePath;
+		double maxRegressionPct = -1.0; // < 0: latency is not compared
+		double minDeltaMs = 0.5;
+		std::uint64_t mctsPlayouts = 0; // > 0 selects the Monte Carlo benchmark
+		bool rootParallel = false;
+		bool threadsGiven = false;
+	};
+
+	std::vector<int> parseIntList(const std::string& text)
+	{
+		std::vector<int> values;
+		std::stringstream ss(text);
+		std::string item;
+		while (std::getline(ss, item, ','))
+		{
+			const int v = std::atoi(item.c_str());
+			if (v > 0)
+				values.push_back(v);
+		}
+		return values;
+	}
+
+	bool parseArgs(int argc, const char* argv[], Options& opt)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string arg = argv[i];
+			auto next = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+
+			if (arg == "--corpus") opt.corpus = next();
+			else if (arg == "--depths") opt.depths = parseIntList(next());
+			else if (arg == "--threads") { opt.threads = parseIntList(next()); opt.threadsGiven = true; }
+			else if (arg == "--iterations") opt.iterations = std::max(1, std::atoi(next().c_str()));
+			else if (arg == "--filter") opt.filter = next();
+			else if (arg == "--json") opt.jsonPath = next();
+			else if (arg == "--hash") opt.hashMb = std::max(1, std::atoi(next().c_str()));
+			else if (arg == "--huge-pages") opt.hugePages = true;
+			else if (arg == "--baseline") opt.baselinePath = next();
+			else if (arg == "--max-regression") opt.maxRegressionPct = std::atof(next().c_str());
+			else if (arg == "--min-delta-ms") opt.minDeltaMs = std::atof(next().c_str());
+			else if (arg == "--mcts") opt.mctsPlayouts = std::strtoull(next().c_str(), nullptr, 10);
+			else if (arg == "--root-parallel") opt.rootParallel = true;
+			else
+			{
+				std::cerr << "unknown option: " << arg << "\n";
+				return false;
+			}
+		}
+		if (opt.mctsPlayouts > 0 && !opt.threadsGiven)
+			opt.threads = { 1, 2, 4, 8 };
+		return !opt.depths.empty() && !opt.threads.empty();
+	}
+
+	// Corpus line: <name> <game> <phase> <moves>; '#' starts a comment.
+	bool loadCorpus(const std::string& path, std::vector<CorpusEntry>& entries)
+	{
+		std::ifstream in(path);
+		if (!in)
+			return false;
+
+		std::string line;
+		while (std::getline(in, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			const size_t hash = line.find('#');
+			if (hash != std::string::npos)
+				line.erase(hash);
+
+			std::stringstream ss(line);
+			CorpusEntry e;
+			if (ss >> e.name >> e.game >> e.phase >> e.moves)
+				entries.push_back(e);
+		}
+		return true;
+	}
+
+	BenchRecord runEntry(const CorpusEntry& entry, const Game& position, int depth, int threads, const Options& opt)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		BenchRecord rec;
+		rec.position = entry.name;
+		rec.game = entry.game;
+		rec.phase = entry.phase;
+		rec.depth = depth;
+		rec.threads = threads;
+
+		std::vector<double> latencies;
+		std::uint64_t totalNodes = 0;
+		double totalWallSec = 0.0;
+
+		AIPlayer ai;
+		ai.setTableSize(static_cast<std::size_t>(opt.hashMb), opt.hugePages);
+		for (int it = 0; it < opt.iterations; ++it)
+		{
+			const auto start = Clock::now();
+			const SearchResult result = ai.search(position, depth, threads);
+			const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+			latencies.push_back(seconds * 1000.0);
+			totalWallSec += seconds;
+			totalNodes += result.nodes;
+			rec.move = result.move;
+			rec.score = result.score;
+			rec.nodes = result.nodes;
+		}
+
+		rec.medianMs = percentile(latencies, 50.0);
+		rec.p95Ms = percentile(latencies, 95.0);
+		rec.nodesPerSec = totalWallSec > 0.0 ? totalNodes / totalWallSec : 0.0;
+		return rec;
+	}
+
+	// Median wall time and playouts/sec of a fixed-playout Monte Carlo search, per thread count
+	void runMonteCarlo(const std::vector<CorpusEntry>& corpus, const Options& opt)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		std::printf("%-16s %-8s %3s %-5s %4s %6s %10s %10s %12s\n",
+			"position", "phase", "thr", "mode", "move", "score", "playouts", "median ms", "kplayouts/s");
+		for (const auto& entry : corpus)
+		{
+			if (entry.game != "c4" || (!opt.filter.empty() && entry.name.find(opt.filter) == std::string::npos && entry.phase != opt.filter))
+				continue;
+			auto position = makePosition(entry.game, entry.moves);
+			if (!position || position->isGameOver())
+				continue;
+
+			for (int threads : opt.threads)
+			{
+				EngineConfig config;
+				config.strategy = SearchStrategy::MonteCarlo;
+				config.nodeBudget = opt.mctsPlayouts;
+				config.threads = threads;
+				config.mctsRootParallel = opt.rootParallel;
+
+				AIPlayer ai;
+				std::vector<double> latencies;
+				std::uint64_t totalPlayouts = 0;
+				double totalWallSec = 0.0;
+				SearchResult result;
+				for (int it = 0; it < opt.iterations; ++it)
+				{
+					const auto start = Clock::now();
+					result = ai.chooseMoveDetailed(*position, config);
+					const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+					latencies.push_back(seconds * 1000.0);
+					totalWallSec += seconds;
+					totalPlayouts += result.nodes;
+				}
+
+				std::printf("%-16s %-8s %3d %-5s %4d %6d %10llu %10.2f %12.1f\n", entry.name.c_str(), entry.phase.c_str(), threads,
+					opt.rootParallel ? "root" : "tree", result.move, result.score, static_cast<unsigned long long>(result.nodes),
+					percentile(latencies, 50.0), totalWallSec > 0.0 ? totalPlayouts / totalWallSec / 1000.0 : 0.0);
+			}
+		}
+	}
+
+	void printTable(const std::vector<BenchRecord>& records)
+	{
+		std::printf("%-16s %-4s %-8s %5s %3s %4s %6s %10s %10s %10s %10s\n",
+			"position", "game", "phase", "depth", "thr", "move", "score", "nodes", "median ms", "p95 ms", "knodes/s");
+		for (const auto& r : records)
+		{
+			std::printf("%-16s %-4s %-8s %5d %3d %4d %6d %10llu %10.2f %10.2f %10.1f\n",
+				r.position.c_str(), r.game.c_str(), r.phase.c_str(), r.depth, r.threads, r.move, r.score,
+				static_cast<unsigned long long>(r.nodes), r.medianMs, r.p95Ms, r.nodesPerSec / 1000.0);
+		}
+	}
+
+	// Returns the number of regressions found against the baseline records.
+	int compareWithBaseline(const std::vector<BenchRecord>& records, const std::vector<BenchRecord>& baseline, const Options& opt)
+	{
+		int regressions = 0;
+		int compared = 0;
+		for (const auto& r : records)
+		{
+			auto it = std::find_if(baseline.begin(), baseline.end(), [&r](const BenchRecord& b) {
+				return b.position == r.position && b.depth == r.depth && b.threads == r.threads;
+				});
+			if (it == baseline.end())
+			{
+				std::printf("NEW      %-16s depth %d thr %d (not in baseline)\n", r.position.c_str(), r.depth, r.threads);
+				continue;
+			}
+			++compared;
+
+			if (r.move != it->move || r.score != it->score)
+			{
+				std::printf("STRENGTH %-16s depth %d thr %d: move %d -> %d, score %d -> %d\n", r.position.c_str(), r.depth, r.threads,
+					it->move, r.move, it->score, r.score);
+				++regressions;
+			}
+
+			// Thread scheduling makes multi-threaded node counts vary from run to run
+			if (r.threads == 1 && r.nodes != it->nodes)
+			{
+				std::printf("NODES    %-16s depth %d thr %d: %llu -> %llu\n", r.position.c_str(), r.depth, r.threads,
+					static_cast<unsigned long long>(it->nodes), static_cast<unsigned long long>(r.nodes));
+				++regressions;
+			}
+
+			const double delta = r.medianMs - it->medianMs;
+			if (opt.maxRegressionPct >= 0.0 && delta > opt.minDeltaMs && r.medianMs > it->medianMs * (1.0 + opt.maxRegressionPct / 100.0))
+			{
+				std::printf("LATENCY  %-16s depth %d thr %d: median %.2f ms -> %.2f ms (+%.0f%%)\n", r.position.c_str(), r.depth, r.threads,
+					it->medianMs, r.medianMs, it->medianMs > 0.0 ? delta * 100.0 / it->medianMs : 0.0);
+				++regressions;
+			}
+		}
+
+		std::printf("compared %d results against baseline: %d regression(s)\n", compared, regressions);
+		return regressions;
+	}
+}
+
+int main(int argc, const char* argv[])
+{
+	Options opt;
+	if (!parseArgs(argc, argv, opt))
+	{
+		std::cerr << "usage: connectxo-bench [--corpus FILE] [--depths 6,8,10] [--threads 1,2] [--iterations N] [--filter TEXT] [--json FILE] [--hash MB [--huge-pages]]\n"
+			"                       [--baseline FILE [--max-regression PCT] [--min-delta-ms MS]]\n"
+			"       connectxo-bench --mcts PLAYOUTS [--threads 1,2,4,8] [--root-parallel] [--iterations N] [--filter TEXT]\n";
+		return 2;
+	}
+
+	std::vector<CorpusEntry> corpus;
+	if (!loadCorpus(opt.corpus, corpus))
+	{
+		std::cerr << "cannot read corpus: " << opt.corpus << "\n";
+		return 2;
+	}
+
+	if (opt.mctsPlayouts > 0)
+	{
+		runMonteCarlo(corpus, opt);
+		return 0;
+	}
+
+	std::vector<BenchRecord> records;
+	for (const auto& entry : corpus)
+	{
+		if (!opt.filter.empty() && entry.name.find(opt.filter) == std::string::npos && entry.phase != opt.filter)
+			continue;
+
+		auto position = makePosition(entry.game, entry.moves);
+		if (!position || position->isGameOver())
+		{
+			std::cerr << "skipping invalid or finished position: " << entry.name << "\n";
+			continue;
+		}
+
+		for (int depth : opt.depths)
+			for (int threads : opt.threads)
+				records.push_back(runEntry(entry, *position, depth, threads, opt));
+	}
+
+	printTable(records);
+
+	if (!opt.jsonPath.empty())
+	{
+		std::ofstream out(opt.jsonPath);
+		if (!out)
+		{
+			std::cerr << "cannot write " << opt.jsonPath << "\n";
+			return 2;
+		}
+		writeBenchJson(out, records, opt.iterations);
+	}
+
+	if (!opt.baselinePath.empty())
+	{
+		std::ifstream in(opt.baselinePath);
+		std::vector<BenchRecord> baseline;
+		if (!in || !readBenchJson(in, baseline))
+		{
+			std::cerr << "cannot read baseline: " << opt.baselinePath << "\n";
+			return 2;
+		}
+		if (compareWithBaseline(records, baseline, opt) > 0)
+			return 1;
+	}
+	return 0;
+}
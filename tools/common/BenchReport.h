@@ -0,0 +1,137 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// One benchmark measurement: a corpus position searched at a given depth / thread count.
+struct BenchRecord
+{
+	std::string position;
+	std::string game;
+	std::string phase;
+	int depth = 0;
+	int threads = 1;
+	int move = -1;
+	int score = 0;
+	std::uint64_t nodes = 0;
+	double medianMs = 0.0;
+	double p95Ms = 0.0;
+	double nodesPerSec = 0.0;
+};
+
+// Nearest-rank percentile (0..100) of the samples; 0 for an empty set.
+inline double percentile(std::vector<double> samples, double pct)
+{
+	if (samples.empty())
+		return 0.0;
+	std::sort(samples.begin(), samples.end());
+	size_t rank = static_cast<size_t>(pct / 100.0 * samples.size() + 0.999999);
+	if (rank < 1)
+		rank = 1;
+	if (rank > samples.size())
+		rank = samples.size();
+	return samples[rank - 1];
+}
+
+inline void writeBenchJson(std::ostream& os, const std::vector<BenchRecord>& records, int iterations)
+{
+	os << "{\n  \"iterations\": " << iterations << ",\n  \"results\": [\n";
+	for (size_t i = 0; i < records.size(); ++i)
+	{
+		const BenchRecord& r = records[i];
+		os << "    {\"position\": \"" << r.position << "\", \"game\": \"" << r.game << "\", \"phase\": \"" << r.phase
+			<< "\", \"depth\": " << r.depth << ", \"threads\": " << r.threads << ", \"move\": " << r.move
+			<< ", \"score\": " << r.score << ", \"nodes\": " << r.nodes << ", \"median_ms\": " << r.medianMs
+			<< ", \"p95_ms\": " << r.p95Ms << ", \"nps\": " << static_cast<std::uint64_t>(r.nodesPerSec) << "}";
+		os << (i + 1 < records.size() ? ",\n" : "\n");
+	}
+	os << "  ]\n}\n";
+}
+
+// Reads back the JSON produced by writeBenchJson. This is not a general JSON parser: it only
+// understands the flat result objects written above (string and number values).
+inline bool readBenchJson(std::istream& is, std::vector<BenchRecord>& records)
+{
+	const std::string text((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+	size_t pos = text.find("\"results\"");
+	if (pos == std::string::npos)
+		return false;
+
+	auto skipSpace = [&]() { while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos; };
+	auto readString = [&](std::string& out) -> bool {
+		skipSpace();
+		if (pos >= text.size() || text[pos] != '"')
+			return false;
+		const size_t end = text.find('"', pos + 1);
+		if (end == std::string::npos)
+			return false;
+		out = text.substr(pos + 1, end - pos - 1);
+		pos = end + 1;
+		return true;
+	};
+
+	while ((pos = text.find('{', pos)) != std::string::npos)
+	{
+		++pos;
+		BenchRecord r;
+		for (;;)
+		{
+			std::string key, strValue;
+			if (!readString(key))
+				return false;
+			skipSpace();
+			if (pos >= text.size() || text[pos] != ':')
+				return false;
+			++pos;
+			skipSpace();
+
+			double num = 0.0;
+			if (pos < text.size() && text[pos] == '"')
+			{
+				if (!readString(strValue))
+					return false;
+			}
+			else
+			{
+				char* end = nullptr;
+				num = std::strtod(text.c_str() + pos, &end);
+				if (end == text.c_str() + pos)
+					return false;
+				pos = end - text.c_str();
+			}
+
+			if (key == "position") r.position = strValue;
+			else if (key == "game") r.game = strValue;
+			else if (key == "phase") r.phase = strValue;
+			else if (key == "depth") r.depth = static_cast<int>(num);
+			else if (key == "threads") r.threads = static_cast<int>(num);
+			else if (key == "move") r.move = static_cast<int>(num);
+			else if (key == "score") r.score = static_cast<int>(num);
+			else if (key == "nodes") r.nodes = static_cast<std::uint64_t>(num);
+			else if (key == "median_ms") r.medianMs = num;
+			else if (key == "p95_ms") r.p95Ms = num;
+			else if (key == "nps") r.nodesPerSec = num;
+
+			skipSpace();
+			if (pos < text.size() && text[pos] == ',')
+			{
+				++pos;
+				continue;
+			}
+			if (pos < text.size() && text[pos] == '}')
+			{
+				++pos;
+				break;
+			}
+			return false;
+		}
+		records.push_back(r);
+	}
+	return true;
+}
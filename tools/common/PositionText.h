@@ -0,0 +1,103 @@
+#pragma once
+#include <charconv>
+#include <memory>
+#include <string>
+#include "AIPlayer.h"
+#include "ConnectFour.h"
+#include "MNKGame.h"
+#include "Qubic.h"
+#include "TicTacToe.h"
+
+// Text form of a position used by the headless tools:
+//   game  - "c4" (Connect Four), "c4-8x7", "c4-9x7", "c4-10x8" (larger boards), "c5" (9x6, five in
+//           a row), "ttt" (Tic-Tac-Toe), "mnk" (15x15 five in a row) or "qubic" (4x4x4)
+//   moves - one digit per move from the start position (column or cell index), "-" for none;
+//           mnk and qubic moves are cell indices (mnk: row * 15 + column, qubic: layer * 16 +
+//           row * 4 + column) separated by commas
+// X always moves first, matching the views.
+
+inline std::unique_ptr<Game> makeGame(const std::string& name)
+{
+	std::unique_ptr<Game> game;
+	if (name == "c4")
+		game = std::make_unique<ConnectFour>();
+	else if (name == "c4-8x7")
+		game = makeConnectBoard(ConnectVariant::Board8x7);
+	else if (name == "c4-9x7")
+		game = makeConnectBoard(ConnectVariant::Board9x7);
+	else if (name == "c4-10x8")
+		game = makeConnectBoard(ConnectVariant::Board10x8);
+	else if (name == "c5")
+		game = makeConnectBoard(ConnectVariant::Connect5);
+	else if (name == "ttt")
+		game = std::make_unique<TicTacToe>();
+	else if (name == "mnk")
+		game = std::make_unique<MNKGame>();
+	else if (name == "qubic")
+		game = std::make_unique<Qubic>();
+
+	if (game)
+		game->reset(Player::X);
+	return game;
+}
+
+// Plays the move string on the given game. Returns false on an illegal or malformed move.
+inline bool applyMoves(Game& game, const std::string& moves)
+{
+	if (moves == "-")
+		return true;
+
+	if (dynamic_cast<const MNKGame*>(&game) || dynamic_cast<const Qubic*>(&game))
+	{
+		size_t start = 0;
+		while (start <= moves.size())
+		{
+			size_t end = moves.find(',', start);
+			if (end == std::string::npos)
+				end = moves.size();
+			// Digits only, and a value that fits; makeMove rejects cells off the board
+			int cell = 0;
+			const char* first = moves.data() + start;
+			const char* last = moves.data() + end;
+			const auto parsed = std::from_chars(first, last, cell);
+			if (first == last || *first < '0' || *first > '9' || parsed.ec != std::errc() || parsed.ptr != last)
+				return false;
+			if (!game.makeMove(cell))
+				return false;
+			start = end + 1;
+		}
+		return true;
+	}
+
+	for (char ch : moves)
+	{
+		if (ch < '0' || ch > '9')
+			return false;
+		if (!game.makeMove(ch - '0'))
+			return false;
+	}
+	return true;
+}
+
+// Appends move to a move string in the format applyMoves expects for game (an empty string is no moves).
+inline void appendMove(const Game& game, std::string& moves, Game::Move move)
+{
+	if (dynamic_cast<const MNKGame*>(&game) || dynamic_cast<const Qubic*>(&game))
+	{
+		if (!moves.empty())
+			moves += ',';
+		moves += std::to_string(move);
+	}
+	else
+	{
+		moves += static_cast<char>('0' + move);
+	}
+}
+
+inline std::unique_ptr<Game> makePosition(const std::string& name, const std::string& moves)
+{
+	auto game = makeGame(name);
+	if (!game || !applyMoves(*game, moves))
+		return nullptr;
+	return game;
+}
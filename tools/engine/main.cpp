@@ -0,0 +1,286 @@
+// connectxo-engine: the AI engine behind a line-based text protocol (in the spirit of UCI),
+// for scripts, analysis jobs on headless servers and external GUIs.
+//
+// Commands (stdin, one per line):
+//   position [GAME] <moves>     set the position; games and moves as in the tools (c4, c4-8x7, c5,
+//                               ttt, mnk, qubic, ...; "-" = empty board)
+//   go depth N [threads T]      search to depth N
+//   go movetime MS [depth N]    iterative deepening for MS milliseconds
+//   go ... multipv K            score the K best moves exactly (multi-PV), reported per depth
+//   stop                        finish the running search and report its best move
+//   eval                        static evaluation for the side to move
+//   hash MB [huge]              resize (and empty) the transposition table; "huge" asks for huge pages
+//   tablebase FILE              probe a Connect 4 endgame tablebase from connectxo-tablebase
+//   isready                     answers "readyok" once the previous commands are processed
+//   quit
+//
+// Output (stdout):
+//   info depth D score S nodes N nps X time MS pv M1 M2 ...
+//   info depth D multipv I score S nodes N nps X time MS pv M1 M2 ...   (one line per move, I = rank)
+//   bestmove M
+// Scores are from the side to move; |S| >= 1000 means a forced win/loss.
+// On end of input the engine finishes the running search before exiting.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "AIPlayer.h"
+#include "PositionText.h"
+#include "Tablebase.h"
+
+namespace
+{
+	class Engine
+	{
+	public:
+		Engine()
+			: _game(makeGame("c4"))
+			, _gameName("c4")
+		{
+		}
+
+		~Engine()
+		{
+			stopSearch();
+		}
+
+		bool handle(const std::string& line)
+		{
+			std::stringstream ss(line);
+			std::string cmd;
+			if (!(ss >> cmd))
+				return true;
+
+			if (cmd == "quit")
+			{
+				stopSearch();
+				return false;
+			}
+			if (cmd == "stop")
+				stopSearch();
+			else if (cmd == "isready")
+				send("readyok");
+			else if (cmd == "position")
+				setPosition(ss);
+			else if (cmd == "go")
+				go(ss);
+			else if (cmd == "eval")
+				eval();
+			else if (cmd == "hash")
+				setHash(ss);
+			else if (cmd == "tablebase")
+				setTablebase(ss);
+			else
+				send("info string unknown command: " + cmd);
+			return true;
+		}
+
+		void waitForSearch()
+		{
+			if (_searchThread.joinable())
+				_searchThread.join();
+		}
+
+	private:
+		void send(const std::string& text)
+		{
+			std::lock_guard<std::mutex> lock(_outMutex);
+			std::cout << text << std::endl;
+		}
+
+		// The flag belongs to the engine and is cleared before each search starts, so a stop that
+		// arrives right after go cannot be lost to the search resetting its own flag.
+		void stopSearch()
+		{
+			_cancel = true;
+			_ai.stop();
+			waitForSearch();
+		}
+
+		void setPosition(std::stringstream& ss)
+		{
+			stopSearch();
+
+			std::string first, moves = "-";
+			ss >> first;
+			std::string name = _gameName;
+			if (makeGame(first))
+			{
+				name = first;
+				ss >> moves;
+			}
+			else if (!first.empty())
+			{
+				moves = first;
+			}
+
+			auto game = makePosition(name, moves);
+			if (!game)
+			{
+				send("info string invalid position");
+				return;
+			}
+			_game = std::move(game);
+			_gameName = name;
+		}
+
+		void setHash(std::stringstream& ss)
+		{
+			stopSearch();
+
+			int megabytes = 0;
+			std::string huge;
+			ss >> megabytes >> huge;
+			if (megabytes <= 0)
+			{
+				send("info string invalid hash size");
+				return;
+			}
+			_ai.setTableSize(static_cast<std::size_t>(megabytes), huge == "huge");
+		}
+
+		void setTablebase(std::stringstream& ss)
+		{
+			stopSearch();
+
+			std::string path;
+			ss >> path;
+			auto tablebase = std::make_shared<Tablebase>();
+			if (path.empty() || !tablebase->open(path))
+			{
+				send("info string cannot open tablebase " + path);
+				return;
+			}
+			_ai.setTablebase(tablebase);
+			send("info string tablebase " + std::to_string(tablebase->size()) + " positions, <= "
+				+ std::to_string(tablebase->maxEmpty()) + " empty cells");
+		}
+
+		void go(std::stringstream& ss)
+		{
+			stopSearch();
+
+			int depth = 0;
+			int moveTimeMs = 0;
+			int threads = 1;
+			int multiPV = 0;
+			std::string key;
+			while (ss >> key)
+			{
+				int value = 0;
+				ss >> value;
+				if (key == "depth") depth = value;
+				else if (key == "movetime") moveTimeMs = value;
+				else if (key == "threads") threads = std::max(1, value);
+				else if (key == "multipv") multiPV = std::max(0, value);
+			}
+
+			if (_game->isGameOver())
+			{
+				send("bestmove none");
+				return;
+			}
+
+			// A time-limited search deepens until the clock runs out (capped by the empty cells).
+			EngineConfig config;
+			config.maxDepth = depth > 0 ? depth : (moveTimeMs > 0 ? static_cast<int>(emptyCells()) : 8);
+			config.timeBudgetMs = moveTimeMs;
+			config.threads = threads;
+			config.cancel = &_cancel;
+
+			_cancel = false;
+			auto snapshot = std::shared_ptr<Game>(_game->clone());
+			if (multiPV > 0)
+			{
+				_searchThread = std::thread([this, snapshot, config, multiPV]() {
+					const auto start = std::chrono::steady_clock::now();
+					auto report = [&](const Analysis& a) {
+						const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+						const auto nps = ms > 0.0 ? static_cast<std::uint64_t>(a.nodes * 1000.0 / ms) : 0;
+						for (size_t i = 0; i < a.moves.size() && i < static_cast<size_t>(multiPV); ++i)
+						{
+							const MoveAnalysis& line = a.moves[i];
+							std::ostringstream os;
+							os << "info depth " << line.depth << " multipv " << i + 1 << " score " << line.score << " nodes " << a.nodes
+								<< " nps " << nps << " time " << static_cast<long long>(ms) << " pv";
+							for (auto move : line.pv)
+								os << ' ' << move;
+							send(os.str());
+						}
+					};
+
+					const Analysis analysis = _ai.analyze(*snapshot, config, multiPV, report);
+					send(analysis.moves.empty() ? std::string("bestmove none") : "bestmove " + std::to_string(analysis.moves.front().move));
+					});
+				return;
+			}
+
+			_searchThread = std::thread([this, snapshot, config]() {
+				const auto start = std::chrono::steady_clock::now();
+				auto report = [&](const SearchResult& r) {
+					const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+					const auto nps = ms > 0.0 ? static_cast<std::uint64_t>(r.nodes * 1000.0 / ms) : 0;
+					std::ostringstream os;
+					os << "info depth " << r.depth << " score " << r.score << " nodes " << r.nodes << " nps " << nps
+						<< " time " << static_cast<long long>(ms) << " pv";
+					for (auto move : r.pv)
+						os << ' ' << move;
+					send(os.str());
+				};
+
+				const SearchResult result = _ai.searchIterative(*snapshot, config, report);
+				send("bestmove " + std::to_string(result.move));
+				});
+		}
+
+		void eval()
+		{
+			if (_game->isGameOver())
+			{
+				const Player winner = _game->getWinner();
+				send(winner == Player::None ? "eval 0 (draw)" : "eval terminal (game over)");
+				return;
+			}
+			send("eval " + std::to_string(evaluateHeuristic(*_game, _game->getCurrentPlayer())));
+		}
+
+		size_t emptyCells() const
+		{
+			if (auto c4 = dynamic_cast<const ConnectBoard*>(_game.get()))
+				return static_cast<size_t>(c4->width() * c4->height() - c4->stoneCount());
+			if (auto mnk = dynamic_cast<const MNKGame*>(_game.get()))
+				return static_cast<size_t>(mnk->width() * mnk->height() - mnk->stoneCount());
+			if (auto qubic = dynamic_cast<const Qubic*>(_game.get()))
+				return static_cast<size_t>(Qubic::kCells - qubic->stoneCount());
+			return _game->getValidMoves().size();
+		}
+
+		AIPlayer _ai;
+		std::unique_ptr<Game> _game;
+		std::string _gameName;
+		std::thread _searchThread;
+		std::atomic<bool> _cancel{ false };
+		std::mutex _outMutex;
+	};
+}
+
+int main()
+{
+	std::ios::sync_with_stdio(false);
+	Engine engine;
+	std::string line;
+	while (std::getline(std::cin, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (!engine.handle(line))
+			return 0;
+	}
+	engine.waitForSearch();
+	return 0;
+}
@@ -0,0 +1,184 @@
+// Perft for the board layer: counts the positions reachable in exactly N moves using only
+// the public Game API (clone / getValidMoves / makeMove). Finished games are not extended.
+//
+//   connectxo-perft --game c4|c4-8x7|c4-9x7|c4-10x8|c5|ttt|qubic [--moves STR] --depth N [--threads N]
+//   connectxo-perft --verify [--threads N]
+//
+// --verify checks the start position of every board against known reference counts and
+// exits non-zero on a mismatch; both modes report positions/sec single- and multi-threaded.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AIPlayer.h"
+#include "PositionText.h"
+
+namespace
+{
+	struct Reference
+	{
+		const char* game;
+		int depth;
+		std::uint64_t count;
+	};
+
+	// Leaf counts from the empty board. Connect Four: 7^N until a column can overflow (N = 7)
+	// and early wins start to cut lines (N = 8). The larger boards were checked against a separate
+	// array-based counter; 9x7 covers the multi-word bitboard. Tic-Tac-Toe sums to 255168
+	// finished games. Qubic: 64 * 63 * ... as no line fills before the seventh stone.
+	const Reference kReferences[] = {
+		{ "c4", 1, 7 }, { "c4", 2, 49 }, { "c4", 3, 343 }, { "c4", 4, 2401 },
+		{ "c4", 5, 16807 }, { "c4", 6, 117649 }, { "c4", 7, 823536 }, { "c4", 8, 5673234 },
+		{ "c4-8x7", 8, 16553656 }, { "c4-9x7", 8, 42569784 }, { "c4-10x8", 6, 1000000 }, { "c5", 7, 4782960 },
+		{ "ttt", 1, 9 }, { "ttt", 2, 72 }, { "ttt", 3, 504 }, { "ttt", 4, 3024 }, { "ttt", 5, 15120 },
+		{ "ttt", 6, 54720 }, { "ttt", 7, 148176 }, { "ttt", 8, 200448 }, { "ttt", 9, 127872 },
+		{ "qubic", 1, 64 }, { "qubic", 2, 4032 }, { "qubic", 3, 249984 }, { "qubic", 4, 15249024 },
+	};
+
+	std::uint64_t perft(const Game& game, int depth)
+	{
+		if (depth == 0)
+			return 1;
+		if (game.isGameOver())
+			return 0;
+
+		std::uint64_t count = 0;
+		for (auto move : game.getValidMoves())
+		{
+			auto next = game.clone();
+			if (next->makeMove(move))
+				count += perft(*next, depth - 1);
+		}
+		return count;
+	}
+
+	// Splits the work on the positions two plies deep so every thread gets enough subtrees.
+	std::uint64_t parallelPerft(const Game& root, int depth, int threads)
+	{
+		if (threads <= 1 || depth < 3)
+			return perft(root, depth);
+
+		std::vector<std::unique_ptr<Game>> tasks;
+		if (!root.isGameOver())
+		{
+			for (auto m1 : root.getValidMoves())
+			{
+				auto g1 = root.clone();
+				if (!g1->makeMove(m1))
+					continue;
+				if (g1->isGameOver())
+					continue; // finished before the split depth: contributes no leaves
+				for (auto m2 : g1->getValidMoves())
+				{
+					auto g2 = g1->clone();
+					if (g2->makeMove(m2))
+						tasks.push_back(std::move(g2));
+				}
+			}
+		}
+
+		std::atomic<size_t> nextTask{ 0 };
+		std::atomic<std::uint64_t> total{ 0 };
+		std::vector<std::thread> workers;
+		for (int t = 0; t < threads; ++t)
+		{
+			workers.emplace_back([&]() {
+				std::uint64_t local = 0;
+				for (size_t i = nextTask++; i < tasks.size(); i = nextTask++)
+					local += perft(*tasks[i], depth - 2);
+				total += local;
+				});
+		}
+		for (auto& w : workers)
+			w.join();
+		return total;
+	}
+
+	struct Timed
+	{
+		std::uint64_t count = 0;
+		double seconds = 0.0;
+	};
+
+	Timed timedPerft(const Game& game, int depth, int threads)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		Timed t;
+		t.count = parallelPerft(game, depth, threads);
+		t.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		return t;
+	}
+
+	void printRow(const char* game, int depth, const Timed& single, const Timed& multi, int threads, const char* status)
+	{
+		auto rate = [](const Timed& t) { return t.seconds > 0.0 ? t.count / t.seconds / 1.0e6 : 0.0; };
+		std::printf("%-7s %5d %12llu %10.3f %10.2f %10.2f (%d thr) %s\n", game, depth, static_cast<unsigned long long>(single.count),
+			single.seconds, rate(single), rate(multi), threads, status);
+	}
+}
+
+int main(int argc, const char* argv[])
+{
+	std::string gameName = "c4";
+	std::string moves = "-";
+	int depth = 0;
+	int threads = std::max(1u, std::thread::hardware_concurrency());
+	bool verify = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		auto next = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+		if (arg == "--game") gameName = next();
+		else if (arg == "--moves") moves = next();
+		else if (arg == "--depth") depth = std::atoi(next().c_str());
+		else if (arg == "--threads") threads = std::max(1, std::atoi(next().c_str()));
+		else if (arg == "--verify") verify = true;
+		else
+		{
+			std::cerr << "usage: connectxo-perft --game c4|c4-8x7|c4-9x7|c4-10x8|c5|ttt|qubic [--moves STR] --depth N [--threads N] | --verify [--threads N]\n";
+			return 2;
+		}
+	}
+
+	std::printf("%-7s %5s %12s %10s %10s %10s\n", "game", "depth", "positions", "seconds", "Mpos/s", "Mpos/s MT");
+
+	if (verify)
+	{
+		int failures = 0;
+		for (const auto& ref : kReferences)
+		{
+			auto game = makeGame(ref.game);
+			const Timed single = timedPerft(*game, ref.depth, 1);
+			const Timed multi = timedPerft(*game, ref.depth, threads);
+			const bool ok = single.count == ref.count && multi.count == ref.count;
+			if (!ok)
+			{
+				++failures;
+				std::printf("expected %llu, multi-threaded %llu\n", static_cast<unsigned long long>(ref.count),
+					static_cast<unsigned long long>(multi.count));
+			}
+			printRow(ref.game, ref.depth, single, multi, threads, ok ? "ok" : "MISMATCH");
+		}
+		return failures == 0 ? 0 : 1;
+	}
+
+	auto game = makePosition(gameName, moves);
+	if (!game || depth < 0)
+	{
+		std::cerr << "invalid position: " << gameName << " " << moves << "\n";
+		return 2;
+	}
+
+	const Timed single = timedPerft(*game, depth, 1);
+	const Timed multi = timedPerft(*game, depth, threads);
+	printRow(gameName.c_str(), depth, single, multi, threads, single.count == multi.count ? "" : "THREAD MISMATCH");
+	return single.count == multi.count ? 0 : 1;
+}
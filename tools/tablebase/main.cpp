@@ -0,0 +1,401 @@
+// connectxo-tablebase: offline retrograde generator for the Connect Four endgame tablebase.
+//
+//   connectxo-tablebase --out FILE [--empty N] [--seeds FILE] [--random-games G] [--seed S]
+//                       [--threads N] [--resume] [--verify K]
+//
+// Seeds are positions with N (default 10) empty cells: each line of --seeds (a move string as
+// in connectxo-batch) continued with random moves until N cells are empty, plus G random games
+// from the empty board stopped at the same point. Every position with at most N empty cells
+// reachable from a seed is enumerated, one layer per empty-cell count. The layers are then solved
+// backwards from one empty cell up: a position's value follows from its children one layer below.
+// Keys are ConnectFour::getCanonicalKey(), so a position and its mirror share one entry. The
+// result is written in the compressed Tablebase format that AIPlayer::setTablebase maps.
+//
+// Every solved layer is checkpointed to FILE.layerK. --resume loads the checkpoints that match
+// the enumerated layers (same seeds and options) instead of solving them again; they are removed
+// once FILE is written. --verify K compares K sampled entries of the written file against a
+// full-depth AIPlayer::search and exits with status 1 on any mismatch.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AIPlayer.h"
+#include "ConnectFour.h"
+#include "PositionText.h"
+#include "Tablebase.h"
+
+namespace
+{
+	struct Options
+	{
+		std::string outPath;
+		int empty = 10;
+		std::string seedsPath;
+		int randomGames = 0;
+		unsigned seed = 1;
+		int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+		bool resume = false;
+		int verify = 0;
+	};
+
+	struct Layer
+	{
+		std::vector<std::uint64_t> keys; // sorted canonical keys
+		std::vector<std::int8_t> values;
+	};
+
+	struct CheckpointHeader
+	{
+		char magic[4];
+		std::uint32_t empty;
+		std::uint64_t count;
+		std::uint64_t keyHash; // followed by count values
+	};
+
+	const char kCheckpointMagic[4] = { 'C', 'X', 'T', 'L' };
+
+	int emptyCells(const ConnectFour& game)
+	{
+		return ConnectFour::CELLS - ConnectFour::stonesOfKey(game.getKey());
+	}
+
+	std::uint64_t canonicalKey(const Game& game)
+	{
+		int symmetry;
+		return game.getCanonicalKey(symmetry);
+	}
+
+	// Calls fn(begin, end, worker) over [0, count) in chunks on the given number of threads
+	template <typename Fn>
+	void parallelFor(std::size_t count, int threads, Fn fn)
+	{
+		const std::size_t chunk = 1024;
+		std::atomic<std::size_t> next{ 0 };
+		std::vector<std::thread> workers;
+		for (int t = 0; t < threads; ++t)
+		{
+			workers.emplace_back([&, t]() {
+				for (std::size_t begin = next.fetch_add(chunk); begin < count; begin = next.fetch_add(chunk))
+					fn(begin, std::min(count, begin + chunk), t);
+				});
+		}
+		for (auto& w : workers)
+			w.join();
+	}
+
+	// Random moves until the board has the given number of empty cells; false if the game ends first.
+	bool extendTo(ConnectFour& game, int empty, std::mt19937& rng)
+	{
+		while (!game.isGameOver() && emptyCells(game) > empty)
+		{
+			const auto moves = game.getValidMoves();
+			game.makeMove(moves[std::uniform_int_distribution<size_t>(0, moves.size() - 1)(rng)]);
+		}
+		return !game.isGameOver();
+	}
+
+	bool collectSeeds(const Options& opt, std::vector<std::uint64_t>& seeds)
+	{
+		std::mt19937 rng(opt.seed);
+		if (!opt.seedsPath.empty())
+		{
+			std::ifstream in(opt.seedsPath);
+			if (!in)
+			{
+				std::cerr << "cannot read seeds: " << opt.seedsPath << "\n";
+				return false;
+			}
+			std::string line;
+			while (std::getline(in, line))
+			{
+				if (!line.empty() && line.back() == '\r')
+					line.pop_back();
+				ConnectFour game;
+				if (line.empty() || !applyMoves(game, line))
+					continue;
+				if (extendTo(game, opt.empty, rng))
+					seeds.push_back(canonicalKey(game));
+			}
+		}
+
+		for (int found = 0, attempts = 0; found < opt.randomGames && attempts < 100 * opt.randomGames; ++attempts)
+		{
+			ConnectFour game;
+			if (extendTo(game, opt.empty, rng))
+			{
+				seeds.push_back(canonicalKey(game));
+				++found;
+			}
+		}
+		return true;
+	}
+
+	void sortUnique(std::vector<std::uint64_t>& keys)
+	{
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+	}
+
+	// Positions that are not over, one move after the positions in above
+	std::vector<std::uint64_t> enumerateBelow(const std::vector<std::uint64_t>& above, int threads)
+	{
+		std::vector<std::vector<std::uint64_t>> found(threads);
+		parallelFor(above.size(), threads, [&](std::size_t begin, std::size_t end, int worker) {
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				ConnectFour game;
+				game.setFromKey(above[i]);
+				for (Game::Move move : game.getValidMoves())
+				{
+					ConnectFour child = game;
+					if (child.makeMove(move) && !child.isGameOver())
+						found[worker].push_back(canonicalKey(child));
+				}
+			}
+			});
+
+		std::vector<std::uint64_t> keys;
+		for (auto& f : found)
+			keys.insert(keys.end(), f.begin(), f.end());
+		sortUnique(keys);
+		return keys;
+	}
+
+	// Value of a position (see Tablebase) from its children's values one layer below
+	bool solvePosition(std::uint64_t key, const Layer& below, std::int8_t& value)
+	{
+		ConnectFour game;
+		if (!game.setFromKey(key))
+			return false;
+		const Player mover = game.getCurrentPlayer();
+		const auto moves = game.getValidMoves();
+		for (Game::Move move : moves)
+		{
+			if (game.isWinningMove(mover, move))
+			{
+				value = 1;
+				return true;
+			}
+		}
+
+		// Rank: win in n plies = 1000 - n, draw = 0, loss in n plies = -1000 + n
+		int bestRank = -2000;
+		int bestValue = 0;
+		for (Game::Move move : moves)
+		{
+			ConnectFour child = game;
+			child.makeMove(move);
+			int rank = 0;
+			int v = 0;
+			if (!child.isGameOver())
+			{
+				const std::uint64_t childKey = canonicalKey(child);
+				auto it = std::lower_bound(below.keys.begin(), below.keys.end(), childKey);
+				if (it == below.keys.end() || *it != childKey)
+					return false;
+				const int childValue = below.values[it - below.keys.begin()];
+				if (childValue < 0)
+					v = -childValue + 1;
+				else if (childValue > 0)
+					v = -(childValue + 1);
+				rank = (v > 0) ? 1000 - v : (v < 0) ? -1000 - v : 0;
+			}
+			if (rank > bestRank)
+			{
+				bestRank = rank;
+				bestValue = v;
+			}
+		}
+		value = static_cast<std::int8_t>(bestValue);
+		return true;
+	}
+
+	std::uint64_t hashKeys(const std::vector<std::uint64_t>& keys)
+	{
+		std::uint64_t h = 1469598103934665603ULL;
+		for (std::uint64_t k : keys)
+			h = (h ^ k) * 1099511628211ULL;
+		return h;
+	}
+
+	std::string checkpointPath(const Options& opt, int empty)
+	{
+		return opt.outPath + ".layer" + std::to_string(empty);
+	}
+
+	bool loadCheckpoint(const Options& opt, int empty, Layer& layer)
+	{
+		std::ifstream in(checkpointPath(opt, empty), std::ios::binary);
+		CheckpointHeader header;
+		if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+			return false;
+		if (std::memcmp(header.magic, kCheckpointMagic, sizeof(kCheckpointMagic)) != 0 || header.empty != static_cast<std::uint32_t>(empty)
+			|| header.count != layer.keys.size() || header.keyHash != hashKeys(layer.keys))
+			return false;
+		layer.values.resize(layer.keys.size());
+		return static_cast<bool>(in.read(reinterpret_cast<char*>(layer.values.data()), static_cast<std::streamsize>(layer.values.size())));
+	}
+
+	bool saveCheckpoint(const Options& opt, int empty, const Layer& layer)
+	{
+		std::ofstream out(checkpointPath(opt, empty), std::ios::binary | std::ios::trunc);
+		CheckpointHeader header;
+		std::memcpy(header.magic, kCheckpointMagic, sizeof(kCheckpointMagic));
+		header.empty = static_cast<std::uint32_t>(empty);
+		header.count = layer.keys.size();
+		header.keyHash = hashKeys(layer.keys);
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		out.write(reinterpret_cast<const char*>(layer.values.data()), static_cast<std::streamsize>(layer.values.size()));
+		return static_cast<bool>(out);
+	}
+
+	// Returns the number of sampled entries whose result differs from a full-depth search
+	int verify(const Options& opt, const std::vector<Tablebase::Entry>& entries)
+	{
+		Tablebase table;
+		if (!table.open(opt.outPath))
+		{
+			std::cerr << "cannot open " << opt.outPath << "\n";
+			return 1;
+		}
+
+		std::mt19937 rng(opt.seed);
+		int mismatches = 0;
+		const int samples = std::min<int>(opt.verify, static_cast<int>(entries.size()));
+		for (int i = 0; i < samples; ++i)
+		{
+			const auto& entry = entries[std::uniform_int_distribution<size_t>(0, entries.size() - 1)(rng)];
+			int stored = 0;
+			const bool found = table.probe(entry.first, stored);
+
+			ConnectFour game;
+			game.setFromKey(entry.first);
+			AIPlayer ai;
+			const SearchResult r = ai.search(game, emptyCells(game), 1);
+			const int searched = (r.score >= 1000) ? 1 : (r.score <= -1000) ? -1 : 0;
+			const int expected = (entry.second > 0) ? 1 : (entry.second < 0) ? -1 : 0;
+			if (!found || stored != entry.second || searched != expected)
+			{
+				std::printf("MISMATCH 0x%llx: table %d (%s), search score %d\n", static_cast<unsigned long long>(entry.first),
+					entry.second, found ? "probed" : "missing", r.score);
+				++mismatches;
+			}
+		}
+		std::printf("verified %d entries: %d mismatch(es)\n", samples, mismatches);
+		return mismatches;
+	}
+}
+
+int main(int argc, const char* argv[])
+{
+	using Clock = std::chrono::steady_clock;
+
+	Options opt;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		auto next = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+		if (arg == "--out") opt.outPath = next();
+		else if (arg == "--empty") opt.empty = std::atoi(next().c_str());
+		else if (arg == "--seeds") opt.seedsPath = next();
+		else if (arg == "--random-games") opt.randomGames = std::max(0, std::atoi(next().c_str()));
+		else if (arg == "--seed") opt.seed = static_cast<unsigned>(std::strtoul(next().c_str(), nullptr, 10));
+		else if (arg == "--threads") opt.threads = std::max(1, std::atoi(next().c_str()));
+		else if (arg == "--resume") opt.resume = true;
+		else if (arg == "--verify") opt.verify = std::max(0, std::atoi(next().c_str()));
+		else
+		{
+			opt.outPath.clear();
+			break;
+		}
+	}
+	if (opt.outPath.empty() || opt.empty < 1 || opt.empty > ConnectFour::CELLS - 1)
+	{
+		std::cerr << "usage: connectxo-tablebase --out FILE [--empty N] [--seeds FILE] [--random-games G] [--seed S]\n"
+			"                           [--threads N] [--resume] [--verify K]\n";
+		return 2;
+	}
+
+	const auto start = Clock::now();
+	auto elapsed = [&]() { return std::chrono::duration<double>(Clock::now() - start).count(); };
+
+	std::vector<std::uint64_t> seeds;
+	if (!collectSeeds(opt, seeds))
+		return 2;
+	sortUnique(seeds);
+	if (seeds.empty())
+	{
+		std::cerr << "no seed positions (use --seeds and/or --random-games)\n";
+		return 2;
+	}
+
+	// layers[e] holds the positions with e empty cells
+	std::vector<Layer> layers(opt.empty + 1);
+	layers[opt.empty].keys = std::move(seeds);
+	for (int e = opt.empty; e > 1; --e)
+	{
+		layers[e - 1].keys = enumerateBelow(layers[e].keys, opt.threads);
+		std::fprintf(stderr, "enumerated %2d empty: %zu positions (%.1f s)\n", e, layers[e].keys.size(), elapsed());
+	}
+
+	for (int e = 1; e <= opt.empty; ++e)
+	{
+		Layer& layer = layers[e];
+		if (opt.resume && loadCheckpoint(opt, e, layer))
+		{
+			std::fprintf(stderr, "resumed   %2d empty: %zu positions\n", e, layer.keys.size());
+			continue;
+		}
+
+		layer.values.assign(layer.keys.size(), 0);
+		std::atomic<bool> failed{ false };
+		parallelFor(layer.keys.size(), opt.threads, [&](std::size_t begin, std::size_t end, int) {
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				if (!solvePosition(layer.keys[i], layers[e - 1], layer.values[i]))
+					failed = true;
+			}
+			});
+		if (failed)
+		{
+			std::cerr << "layer " << e << ": a child position is missing from the layer below\n";
+			return 1;
+		}
+		if (!saveCheckpoint(opt, e, layer))
+			std::cerr << "warning: cannot write checkpoint " << checkpointPath(opt, e) << "\n";
+		std::fprintf(stderr, "solved    %2d empty: %zu positions (%.1f s)\n", e, layer.keys.size(), elapsed());
+	}
+
+	std::vector<Tablebase::Entry> entries;
+	for (int e = 1; e <= opt.empty; ++e)
+	{
+		for (std::size_t i = 0; i < layers[e].keys.size(); ++i)
+			entries.emplace_back(layers[e].keys[i], layers[e].values[i]);
+	}
+	std::sort(entries.begin(), entries.end());
+	if (!Tablebase::write(opt.outPath, opt.empty, entries))
+	{
+		std::cerr << "cannot write " << opt.outPath << "\n";
+		return 2;
+	}
+	for (int e = 1; e <= opt.empty; ++e)
+		std::remove(checkpointPath(opt, e).c_str());
+
+	std::ifstream written(opt.outPath, std::ios::binary | std::ios::ate);
+	const double bytes = static_cast<double>(written.tellg());
+	std::printf("wrote %zu positions with <= %d empty cells to %s: %.1f MB, %.2f bytes/position (%.1f s)\n", entries.size(), opt.empty,
+		opt.outPath.c_str(), bytes / (1 << 20), bytes / entries.size(), elapsed());
+
+	if (opt.verify > 0 && verify(opt, entries) > 0)
+		return 1;
+	return 0;
+}
@@ -0,0 +1,287 @@
+// connectxo-tournament: AIPlayer vs AIPlayer self-play to rate the difficulty tiers.
+//
+//   connectxo-tournament [--game c4|c4-8x7|c4-9x7|c4-10x8|c5|ttt|mnk|qubic|both] [--pairings 0-1,1-2|adjacent|all]
+//                        [--openings N] [--random-plies K] [--depth D] [--threads N] [--seed S]
+//                        [--mcts a|b|both]
+//
+// Every pairing A-B plays each opening twice with colors swapped. An opening is K random
+// legal plies from the empty board (same seed -> same openings for every pairing), after which
+// both engines play chooseMove up to the requested depth within their own tier's budget.
+// Per pairing it reports A's win/draw/loss, the Elo difference A - B with a 95% interval,
+// and the average think time per move of each side. --mcts switches side A, B or both to the
+// Monte Carlo strategy with the same tier budgets (counted in playouts).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AIPlayer.h"
+#include "PositionText.h"
+
+namespace
+{
+	const char* kTierNames[] = { "VeryEasy", "Easy", "Medium", "Hard", "VeryHard" };
+
+	struct Pairing
+	{
+		int a = 0;
+		int b = 0;
+	};
+
+	struct GameTask
+	{
+		std::string game;
+		size_t pairing = 0;
+		std::string opening; // move string
+		bool aIsX = true;
+
+		// results
+		bool played = false; // false if the opening could not be set up
+		double scoreA = 0.0; // 1 win, 0.5 draw, 0 loss
+		double thinkMsA = 0.0;
+		double thinkMsB = 0.0;
+		int movesA = 0;
+		int movesB = 0;
+	};
+
+	struct Options
+	{
+		std::vector<std::string> games{ "c4", "ttt" };
+		std::string pairings = "adjacent";
+		int openings = 20;
+		int randomPlies = 2;
+		int depth = 10;
+		int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+		unsigned seed = 1;
+		bool mctsA = false;
+		bool mctsB = false;
+	};
+
+	std::vector<Pairing> parsePairings(const std::string& text)
+	{
+		std::vector<Pairing> result;
+		if (text == "adjacent" || text == "all")
+		{
+			for (int a = 0; a < 5; ++a)
+				for (int b = a + 1; b < 5; ++b)
+					if (text == "all" || b == a + 1)
+						result.push_back({ a, b });
+			return result;
+		}
+
+		std::stringstream ss(text);
+		std::string item;
+		while (std::getline(ss, item, ','))
+		{
+			Pairing p;
+			if (std::sscanf(item.c_str(), "%d-%d", &p.a, &p.b) == 2 && p.a >= 0 && p.a <= 4 && p.b >= 0 && p.b <= 4)
+				result.push_back(p);
+		}
+		return result;
+	}
+
+	// Random legal plies that do not end the game.
+	std::string randomOpening(const std::string& gameName, int plies, std::mt19937& rng)
+	{
+		for (int attempt = 0; attempt < 100; ++attempt)
+		{
+			auto game = makeGame(gameName);
+			std::string moves;
+			for (int i = 0; i < plies && !game->isGameOver(); ++i)
+			{
+				const auto valid = game->getValidMoves();
+				const auto move = valid[std::uniform_int_distribution<size_t>(0, valid.size() - 1)(rng)];
+				appendMove(*game, moves, move);
+				game->makeMove(move);
+			}
+			if (!game->isGameOver())
+				return moves.empty() ? "-" : moves;
+		}
+		return "-";
+	}
+
+	void playGame(GameTask& task, const Pairing& pairing, const Options& opt)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		auto game = makePosition(task.game, task.opening);
+		if (!game)
+		{
+			std::fprintf(stderr, "invalid opening for %s: %s\n", task.game.c_str(), task.opening.c_str());
+			return;
+		}
+		task.played = true;
+		AIPlayer playerA, playerB;
+		EngineConfig configA = EngineConfig::forDifficulty(pairing.a, opt.depth);
+		EngineConfig configB = EngineConfig::forDifficulty(pairing.b, opt.depth);
+		if (opt.mctsA) configA.strategy = SearchStrategy::MonteCarlo;
+		if (opt.mctsB) configB.strategy = SearchStrategy::MonteCarlo;
+		const Player sideA = task.aIsX ? Player::X : Player::O;
+
+		while (!game->isGameOver())
+		{
+			const bool aToMove = game->getCurrentPlayer() == sideA;
+			AIPlayer& ai = aToMove ? playerA : playerB;
+
+			const auto start = Clock::now();
+			const SearchResult r = ai.chooseMoveDetailed(*game, aToMove ? configA : configB);
+			const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+			if (aToMove) { task.thinkMsA += ms; ++task.movesA; }
+			else { task.thinkMsB += ms; ++task.movesB; }
+
+			if (r.move < 0 || !game->makeMove(r.move))
+				break;
+		}
+
+		const Player winner = game->getWinner();
+		task.scoreA = (winner == Player::None) ? 0.5 : (winner == sideA ? 1.0 : 0.0);
+	}
+
+	double eloFromScore(double s)
+	{
+		s = std::clamp(s, 0.001, 0.999);
+		return -400.0 * std::log10(1.0 / s - 1.0);
+	}
+
+	void report(const std::string& gameName, const std::vector<Pairing>& pairings, const std::vector<GameTask>& tasks)
+	{
+		std::printf("\n%s\n%-20s %6s %5s %5s %5s %8s %18s %10s %10s\n", gameName == "c4" ? "Connect Four" : gameName == "ttt" ? "Tic-Tac-Toe" : gameName.c_str(),
+			"pairing (A-B)", "games", "W", "D", "L", "Elo A-B", "95% interval", "ms/mv A", "ms/mv B");
+
+		for (size_t p = 0; p < pairings.size(); ++p)
+		{
+			int games = 0, wins = 0, draws = 0, losses = 0, movesA = 0, movesB = 0;
+			double sum = 0.0, sumSq = 0.0, msA = 0.0, msB = 0.0;
+			for (const auto& t : tasks)
+			{
+				if (t.game != gameName || t.pairing != p || !t.played)
+					continue;
+				++games;
+				sum += t.scoreA;
+				sumSq += t.scoreA * t.scoreA;
+				wins += t.scoreA == 1.0;
+				draws += t.scoreA == 0.5;
+				losses += t.scoreA == 0.0;
+				msA += t.thinkMsA;
+				msB += t.thinkMsB;
+				movesA += t.movesA;
+				movesB += t.movesB;
+			}
+			if (games == 0)
+				continue;
+
+			const double mean = sum / games;
+			const double variance = std::max(0.0, sumSq / games - mean * mean);
+			const double margin = 1.96 * std::sqrt(variance / games);
+
+			char label[32];
+			std::snprintf(label, sizeof(label), "%s-%s", kTierNames[pairings[p].a], kTierNames[pairings[p].b]);
+			char interval[32];
+			std::snprintf(interval, sizeof(interval), "[%+.0f, %+.0f]", eloFromScore(mean - margin), eloFromScore(mean + margin));
+			std::printf("%-20s %6d %5d %5d %5d %+8.0f %18s %10.2f %10.2f\n", label, games, wins, draws, losses, eloFromScore(mean), interval,
+				movesA ? msA / movesA : 0.0, movesB ? msB / movesB : 0.0);
+		}
+	}
+}
+
+int main(int argc, const char* argv[])
+{
+	Options opt;
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		auto next = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+		if (arg == "--game")
+		{
+			const std::string g = next();
+			opt.games = (g == "both") ? std::vector<std::string>{ "c4", "ttt" } : std::vector<std::string>{ g };
+		}
+		else if (arg == "--pairings") opt.pairings = next();
+		else if (arg == "--openings") opt.openings = std::max(1, std::atoi(next().c_str()));
+		else if (arg == "--random-plies") opt.randomPlies = std::max(0, std::atoi(next().c_str()));
+		else if (arg == "--depth") opt.depth = std::max(1, std::atoi(next().c_str()));
+		else if (arg == "--threads") opt.threads = std::max(1, std::atoi(next().c_str()));
+		else if (arg == "--seed") opt.seed = static_cast<unsigned>(std::strtoul(next().c_str(), nullptr, 10));
+		else if (arg == "--mcts")
+		{
+			const std::string side = next();
+			opt.mctsA = (side == "a" || side == "both");
+			opt.mctsB = (side == "b" || side == "both");
+		}
+		else
+		{
+			std::cerr << "usage: connectxo-tournament [--game c4|c4-8x7|c4-9x7|c4-10x8|c5|ttt|mnk|qubic|both] [--pairings 0-1,1-2|adjacent|all] [--openings N]\n"
+				"                            [--random-plies K] [--depth D] [--threads N] [--seed S] [--mcts a|b|both]\n";
+			return 2;
+		}
+	}
+
+	const auto pairings = parsePairings(opt.pairings);
+	if (pairings.empty())
+	{
+		std::cerr << "no valid pairings in: " << opt.pairings << "\n";
+		return 2;
+	}
+
+	std::vector<GameTask> tasks;
+	for (const auto& gameName : opt.games)
+	{
+		if (!makeGame(gameName))
+		{
+			std::cerr << "unknown game: " << gameName << "\n";
+			return 2;
+		}
+
+		std::mt19937 rng(opt.seed);
+		std::vector<std::string> openings;
+		for (int i = 0; i < opt.openings; ++i)
+			openings.push_back(randomOpening(gameName, opt.randomPlies, rng));
+
+		for (size_t p = 0; p < pairings.size(); ++p)
+		{
+			for (const auto& opening : openings)
+			{
+				for (bool aIsX : { true, false })
+				{
+					GameTask t;
+					t.game = gameName;
+					t.pairing = p;
+					t.opening = opening;
+					t.aIsX = aIsX;
+					tasks.push_back(t);
+				}
+			}
+		}
+	}
+
+	std::atomic<size_t> next{ 0 };
+	std::atomic<size_t> done{ 0 };
+	std::vector<std::thread> workers;
+	for (int t = 0; t < opt.threads; ++t)
+	{
+		workers.emplace_back([&]() {
+			for (size_t i = next++; i < tasks.size(); i = next++)
+			{
+				playGame(tasks[i], pairings[tasks[i].pairing], opt);
+				const size_t finished = ++done;
+				if (finished % 50 == 0)
+					std::fprintf(stderr, "%zu / %zu games\n", finished, tasks.size());
+			}
+			});
+	}
+	for (auto& w : workers)
+		w.join();
+
+	for (const auto& gameName : opt.games)
+		report(gameName, pairings, tasks);
+	return 0;
+}